@@ -16,6 +16,8 @@
 
 /* --------------------------- Private macros ----------------------------- */
 #define NUM_BUTTONS (sizeof(buttonsPinRef) / sizeof(input_pinref_t))
+#define PINS_PER_PORT 8
+#define BUTTON_NONE (-1)    /* Sentinel of the pin to button table */
 
 /* ----------------------- Private data types ------------------------- */
 /* Private constant with references to button pins */
@@ -34,12 +36,25 @@ static const input_pinref_t buttonsPinRef[] = {
     {.odd = P3, .port_is_odd = 1, .mask = BIT5, .use_pullup = 0, .use_interrupt = 0, .int_num = 0},
 };
 
+/* Private type with the inputs of a port and their last snapshot */
+typedef struct {
+    volatile const uint8_t *in;             /* PxIN register of the port */
+    uint8_t mask;                           /* Pins of the port used as inputs */
+    uint8_t last;                           /* PxIN & mask at the previous scan */
+    int8_t pin_button[PINS_PER_PORT];       /* Button index of each pin (BUTTON_NONE if unused) */
+} button_port_t;
+
 /* ----------- Definition of private variables (with static) -------------- */
+/* Private array with the ports used by buttonsPinRef, built in buttonsInit */
+static button_port_t buttonsPorts[NUM_BUTTONS];
+static uint8_t buttonsNumPorts;
 
 /* ----------------- Definition of public variables --------------------- */
 
 /* ---------- Declaration of private functions (with static) -------------- */
 static void _buttonInit(const input_pinref_t *ref);
+static volatile const uint8_t *_buttonIn(const input_pinref_t *ref);
+static void _buttonsPortsInit(void);
 
 /* --------- Implementation of private functions (with static) ------------ */
 static void _buttonInit(const input_pinref_t *ref)
@@ -68,6 +83,59 @@ static void _buttonInit(const input_pinref_t *ref)
     }
 }
 
+static volatile const uint8_t *_buttonIn(const input_pinref_t *ref)
+{
+    if (ref->port_is_odd)
+    {
+        return &(ref->odd->IN);
+    }
+    else
+    {
+        return &(ref->even->IN);
+    }
+}
+
+/* Group the inputs of buttonsPinRef by port and take the first snapshot */
+static void _buttonsPortsInit(void)
+{
+    uint8_t i, g, pin;
+    volatile const uint8_t *in;
+    buttonsNumPorts = 0;
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        in = _buttonIn(&buttonsPinRef[i]);
+        for (g = 0; g < buttonsNumPorts; g++)
+        {
+            if (buttonsPorts[g].in == in)
+            {
+                break;
+            }
+        }
+        if (g == buttonsNumPorts)
+        {
+            buttonsPorts[g].in = in;
+            buttonsPorts[g].mask = 0;
+            for (pin = 0; pin < PINS_PER_PORT; pin++)
+            {
+                buttonsPorts[g].pin_button[pin] = BUTTON_NONE;
+            }
+            buttonsNumPorts++;
+        }
+        buttonsPorts[g].mask |= buttonsPinRef[i].mask;
+        for (pin = 0; pin < PINS_PER_PORT; pin++)
+        {
+            if (buttonsPinRef[i].mask & (1 << pin))
+            {
+                buttonsPorts[g].pin_button[pin] = i;
+            }
+        }
+    }
+    for (g = 0; g < buttonsNumPorts; g++)
+    {
+        buttonsPorts[g].last = *buttonsPorts[g].in & buttonsPorts[g].mask;
+    }
+}
+
 /* ---------------- Implementation of public functions ------------------ */
 void buttonsInit()
 {
@@ -76,6 +144,7 @@ void buttonsInit()
     {
         _buttonInit(&(buttonsPinRef[i]));
     }
+    _buttonsPortsInit();
 }
 
 button_val_t buttonGet(button_ref_t button_ref)
@@ -104,4 +173,31 @@ int buttonsGetNum(void)
     return NUM_BUTTONS;
 }
 
+void buttonsScan(void)
+{
+    uint8_t g, pin, now, changed;
+    for (g = 0; g < buttonsNumPorts; g++)
+    {
+        /* One register read per port, nothing else unless a pin changed */
+        now = *buttonsPorts[g].in & buttonsPorts[g].mask;
+        changed = now ^ buttonsPorts[g].last;
+        if (changed == 0)
+        {
+            continue;
+        }
+        buttonsPorts[g].last = now;
+        for (pin = 0; changed != 0; pin++, changed >>= 1)
+        {
+            if (changed & 1)
+            {
+                buttonChangeCallback(buttonsPorts[g].pin_button[pin],
+                                     (now & (1 << pin)) ? BUTTON_RELEASED : BUTTON_PRESSED);
+            }
+        }
+    }
+}
+
+void buttonChangeCallback(int button_index, button_val_t value) __attribute__((weak));
+void buttonChangeCallback(int button_index, button_val_t value){}
+
 /* @} */
@@ -11,6 +11,8 @@
  *The public function buttons_init intializes the hardware for the buttons to be used.
  *The public function buttonGet() takes a button_ref_t parameter as input to return the state of this button.
  *The public function buttonsGetNum() returns an integer containing the amount of buttons on this board.
+ *The public function buttonsScan() reads each input port once, compares it with the previous scan and
+ *calls buttonChangeCallback() only for the buttons that changed.
  *
  * @{
  */
@@ -43,6 +45,8 @@ BP_S2 /* BoosterPack , button S2 */
 void buttonsInit(void);
 button_val_t buttonGet(button_ref_t button_ref);
 int buttonsGetNum(void);
+void buttonsScan(void);
+extern void buttonChangeCallback(int button_index, button_val_t value);
 
 /* @} */
 
@@ -13,6 +13,7 @@
 
 /* ---------------- #includes needed for this file ----------------- */
 #include "stime.h"
+#include "critical.h"
 
 /* --------------------------- Private macros ----------------------------- */
 
@@ -50,9 +51,9 @@ void stimeInit(uint32_t clkHz){
 
 uint64_t stimeElapsedMillis(void){
     uint64_t millis;
-    stickDisableInt();
+    critical_t s = criticalEnter();
     millis = ms;
-    stickEnableInt();
+    criticalExit(s);
     return millis;
 }
 
@@ -0,0 +1,48 @@
+/**
+ * @file critical.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Header file with the nestable critical sections.
+ *
+ * criticalEnter() saves PRIMASK and masks every interrupt, criticalExit() puts the saved
+ * value back. A section opened inside another one, from an interrupt handler or with the
+ * interrupts already masked never unmasks them early, unlike a disable/enable pair.
+ * On the target a section is MRS and CPSID on entry and one MSR on exit.
+ *
+ * @{
+ */
+#ifndef __CRITICAL_H
+#define __CRITICAL_H
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+/* --------------------------- Public macros ----------------------------- */
+
+
+/* ----------------------- Public data types ------------------------- */
+/* Interrupt state saved by criticalEnter() */
+typedef uint32_t critical_t;
+
+/* ---- Declaration of public variables (no definition, use extern) ----- */
+
+
+/* -------- Declaration of public functions (optional extern) ------------ */
+
+// Mask every interrupt. Returns the state to give to criticalExit()
+static inline critical_t criticalEnter(void){
+    critical_t s = __get_PRIMASK();
+    __disable_irq();
+    return s;
+}
+
+// Restore the state saved by the matching criticalEnter()
+static inline void criticalExit(critical_t s){
+    __set_PRIMASK(s);
+}
+
+/* @} */
+
+#endif // __CRITICAL_H
@@ -13,6 +13,7 @@
 
 /* ---------------- #includes needed for this file ----------------- */
 #include "stime.h"
+#include "critical.h"
 
 /* --------------------------- Private macros ----------------------------- */
 
@@ -69,9 +70,9 @@ void stimeInit(uint32_t clkHz){
 
 uint64_t stimeElapsedMillis(void){
     uint64_t millis;
-    stickDisableInt();
+    critical_t s = criticalEnter();
     millis = ms;
-    stickEnableInt();
+    criticalExit(s);
     return millis;
 }
 
@@ -83,10 +84,10 @@ void stimeWaitMillis(uint32_t millis){
 }
 
 void stimeExecMillis (uint32_t millis){
-    stickDisableInt();
+    critical_t s = criticalEnter();
     timed_exec_period = millis;
     timed_exec_count = 0;
-    stickEnableInt();
+    criticalExit(s);
 }
 
 
@@ -0,0 +1,134 @@
+/**
+ * @file bench.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief A source file for the leds and buttons cycle benchmarks.
+ *
+ * The interrupt is called directly, once per bit plane, on the running modulation: the
+ * led shows one wrong frame during the run. The DWT read itself costs a few cycles and
+ * is included in the figures. The port flags are raised by software, which PxIFG allows,
+ * and the pending port interrupt is cleared in the NVIC before interrupts are unmasked.
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include "bench.h"
+#include "leds.h"
+#include "buttons.h"
+
+/* --------------------------- Private macros ----------------------------- */
+#define BENCH_PLANES 8          /* Calls to cover every bit plane */
+
+/* ----------------------- Private data types ------------------------- */
+
+/* ----------- Definition of private variables (with static) -------------- */
+
+/* ----------------- Definition of public variables --------------------- */
+
+/* ---------- Declaration of private functions (with static) -------------- */
+void TA3_0_IRQHandler(void);
+void PORT5_IRQHandler(void);
+static uint32_t _benchPort5(uint8_t pins);
+
+/* --------- Implementation of private functions (with static) ------------ */
+/* Slowest PORT5_IRQHandler() over BENCH_IRQ_CALLS with the pins raised, interrupts masked.
+   Pins without an input are enabled for the call only, the inputs stay disarmed */
+static uint32_t _benchPort5(uint8_t pins)
+{
+    uint32_t i, start, cycles, max = 0;
+    uint8_t ie = P5->IE;
+    for (i = 0; i < BENCH_IRQ_CALLS; i++)
+    {
+        P5->IE |= pins;
+        P5->IFG |= pins;
+        start = DWT->CYCCNT;
+        PORT5_IRQHandler();
+        cycles = DWT->CYCCNT - start;
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+    P5->IE &= ie;
+    Interrupt_unpendInterrupt(INT_PORT5);
+    return max;
+}
+
+/* ---------------- Implementation of public functions ------------------ */
+void benchRun(uint8_t red_ref, bench_result_t *r)
+{
+    uint32_t i, start, cycles, total = 0, max = 0, primask;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* A first dimmed colour starts the modulation, outside the measure */
+    ledSetHsv((led_ref_t)red_ref, 0, 255, 128);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (i = 0; i < BENCH_HSV_CALLS; i++)
+    {
+        start = DWT->CYCCNT;
+        ledSetHsv((led_ref_t)red_ref, (uint16_t)(i * LED_HUE_MAX / BENCH_HSV_CALLS), 255, 128);
+        cycles = DWT->CYCCNT - start;
+        total += cycles;
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+    r->hsv_cycles = (total + BENCH_HSV_CALLS / 2) / BENCH_HSV_CALLS;
+    r->hsv_cycles_max = max;
+
+    max = 0;
+    for (i = 0; i < BENCH_PLANES; i++)
+    {
+        start = DWT->CYCCNT;
+        TA3_0_IRQHandler();
+        cycles = DWT->CYCCNT - start;
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+    r->isr_cycles_max = max;
+    __set_PRIMASK(primask);
+
+    r->mclk_hz = CS_getMCLK();
+}
+
+void benchButtonsRun(bench_buttons_t *r)
+{
+    uint32_t i, start, cycles, total = 0, max = 0, primask;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    r->irq_one_cycles = _benchPort5(BIT1);
+    r->irq_port_cycles = _benchPort5(0xFF);
+
+    for (i = 0; i < BENCH_TICKS; i++)
+    {
+        start = DWT->CYCCNT;
+        stimeTickCallback();
+        cycles = DWT->CYCCNT - start;
+        total += cycles;
+        if (cycles > max)
+        {
+            max = cycles;
+        }
+    }
+    r->tick_cycles = (total + BENCH_TICKS / 2) / BENCH_TICKS;
+    r->tick_cycles_max = max;
+    __set_PRIMASK(primask);
+
+    r->inputs = buttonsGetNum();
+    r->mclk_hz = CS_getMCLK();
+}
+
+/* @} */
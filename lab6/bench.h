@@ -0,0 +1,62 @@
+/**
+ * @file bench.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Header file of the leds and buttons cycle benchmarks.
+ *
+ * The DWT cycle counter measures, with interrupts masked, the cost of a colour update
+ * (ledSetHsv(), conversion and three ledSetLevel()) and of the bit plane interrupt
+ * TA3_0_IRQHandler(), which must stay below LEDS_PWM_ISR_CYCLES (leds.c), and the
+ * port interrupt dispatch of the buttons module (PORT5_IRQHandler()) with one pin and with
+ * the whole port pending. P5 holds BP_S1 in the board build and eight inputs in the build
+ * with BUTTONS_BENCH_INPUTS=48 and BUTTONS_BENCH_INTERRUPT=1: run both to compare 4 and 48
+ * inputs. The 1 ms tick of the module, stimeTickCallback(), is timed too: build with
+ * BUTTONS_BENCH_INPUTS = 0 (board), 16 and 48 (polled, so every integrator samples), with
+ * and without BUTTONS_DEBOUNCE_VERTICAL, to compare the integrator and the vertical counters.
+ * Build with MAIN_BENCH defined and read benchResult and benchButtons in the debugger.
+ *
+ * @{
+ */
+#ifndef __BENCH_H
+#define __BENCH_H
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdint.h>
+
+/* --------------------------- Public macros ----------------------------- */
+#define BENCH_HSV_CALLS 256     /* ledSetHsv() calls averaged, hue swept over the whole circle */
+#define BENCH_IRQ_CALLS 16      /* Port handler calls per figure, the slowest is kept */
+#define BENCH_TICKS 240         /* stimeTickCallback() calls averaged, a multiple of the sample periods */
+
+/* ----------------------- Public data types ------------------------- */
+/* Result of one run, in MCLK cycles */
+typedef struct {
+    uint32_t mclk_hz;           /* MCLK during the run */
+    uint32_t hsv_cycles;        /* Average ledSetHsv() */
+    uint32_t hsv_cycles_max;    /* Slowest ledSetHsv() */
+    uint32_t isr_cycles_max;    /* Slowest TA3_0_IRQHandler() over the eight planes */
+} bench_result_t;
+
+/* Result of the buttons run, in MCLK cycles */
+typedef struct {
+    uint32_t mclk_hz;           /* MCLK during the run */
+    uint32_t inputs;            /* buttonsGetNum() of the build */
+    uint32_t irq_one_cycles;    /* Slowest PORT5_IRQHandler() with P5.1 pending */
+    uint32_t irq_port_cycles;   /* Slowest PORT5_IRQHandler() with the eight P5 pins pending */
+    uint32_t tick_cycles;       /* Average stimeTickCallback(), inputs at rest */
+    uint32_t tick_cycles_max;   /* Slowest stimeTickCallback(): a sample of the vertical counters */
+} bench_buttons_t;
+
+/* ---- Declaration of public variables (no definition, use extern) ----- */
+
+/* ---------------- Declaration of public functions ------------------ */
+/* Run the benchmark on the red, green and blue channels starting at red_ref (foreground).
+ * Leaves the led at the last colour of the sweep. */
+void benchRun(uint8_t red_ref, bench_result_t *r);
+/* Run the buttons benchmark, after buttonsInit(). Wakes up the filters of the P5 inputs,
+ * which arm their pins again from the next ticks. */
+void benchButtonsRun(bench_buttons_t *r);
+
+#endif
+/* @} */
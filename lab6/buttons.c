@@ -7,7 +7,17 @@
  *
  *  A source file to be to be used by the user to control the buttons on a msp432p401r Launchpad board.
  *  This contains the implementation for the private and public functions for the buttons module.
- *  This module also contains the implementation of anti rebound of the buttons in the private handlers.
+ *  This module also contains the implementation of anti rebound of the buttons.
+ *  Every input is filtered by an integrator sampled from the 1 ms stime tick: the debounced state only
+ *  changes after the pin has read the new level for the whole settle time (press and release have their own).
+ *  Interrupt driven inputs are only sampled while they are moving: the first edge disables the pin
+ *  interrupt and wakes the filter up, and the filter re-arms the pin (waiting for the opposite edge)
+ *  once the level has settled. So the port handlers run once per press or release, not once per bounce.
+ *  With BUTTONS_DEBOUNCE_VERTICAL the inputs are grouped by port instead, and the eight pins of a port
+ *  are debounced at once with 2 bits vertical counters (four equal samples to toggle), so the cost of
+ *  a tick grows with the number of ports in use, not with the number of inputs.
+ *  Inputs with use_capture are not debounced: the port handler timestamps both edges with the DWT cycle
+ *  counter, flipping PxIES after each edge, to measure exact pulse widths and hold times.
  *
  * @{
  */
@@ -17,11 +27,28 @@
 
 /* --------------------------- Private macros ----------------------------- */
 #define NUM_BUTTONS (sizeof(buttonsPinRef) / sizeof(input_pinref_t))
+#define NUM_INT_PORTS 6     /* Ports with interrupts: P1 to P6 */
+#define PINS_PER_PORT 8
+#define BUTTON_NONE (-1)    /* Sentinel of the interrupt dispatch table */
+/* Read of PxIV, which clears the flag it reports. The host checks in tools/ model it */
+#ifndef BUTTONS_READ_IV
+#define BUTTONS_READ_IV(reg) (*(reg))
+#endif
+/* The eight pins of port p as bench inputs, pulled up */
+#define BUTTONS_BENCH_PORT(p, side, is_odd) \
+    BUTTONS_BENCH_PIN(p, side, is_odd, BIT0), BUTTONS_BENCH_PIN(p, side, is_odd, BIT1), \
+    BUTTONS_BENCH_PIN(p, side, is_odd, BIT2), BUTTONS_BENCH_PIN(p, side, is_odd, BIT3), \
+    BUTTONS_BENCH_PIN(p, side, is_odd, BIT4), BUTTONS_BENCH_PIN(p, side, is_odd, BIT5), \
+    BUTTONS_BENCH_PIN(p, side, is_odd, BIT6), BUTTONS_BENCH_PIN(p, side, is_odd, BIT7)
+#define BUTTONS_BENCH_PIN(p, side, is_odd, bit) \
+    {.side = P##p, .port_is_odd = is_odd, .mask = bit, .use_pullup = 1, \
+     .use_interrupt = BUTTONS_BENCH_INTERRUPT, .int_num = INT_PORT##p}
 
 /* ----------------------- Private data types ------------------------- */
 /* Private constant with references to button pins */
 static const input_pinref_t buttonsPinRef[] =
 {
+#if BUTTONS_BENCH_INPUTS == 0
      /* LP_S1 on P1.1 , internal pull-up */
      {.odd = P1, .port_is_odd = 1, .mask = BIT1, .use_pullup = 1, .use_interrupt = 0, .int_num = 0},
      /* LP_S2 on P1 .4 , internal pull-up  */
@@ -32,58 +59,87 @@ static const input_pinref_t buttonsPinRef[] =
 
      /* BP_S2 on P3 .5 , no internal pull-up  */
      {.odd = P3, .port_is_odd = 1, .mask = BIT5, .use_pullup = 0, .use_interrupt = 1, .int_num = INT_PORT3},
+#else
+     /* Bench build: P1 and P2, then P3 to P6 for 48 inputs. The leds on them are unusable */
+     BUTTONS_BENCH_PORT(1, odd, 1),
+     BUTTONS_BENCH_PORT(2, even, 0),
+#if BUTTONS_BENCH_INPUTS > 16
+     BUTTONS_BENCH_PORT(3, odd, 1),
+     BUTTONS_BENCH_PORT(4, even, 0),
+     BUTTONS_BENCH_PORT(5, odd, 1),
+     BUTTONS_BENCH_PORT(6, even, 0),
+#endif
+#endif
 };
-/* Private array of last interrupt for a button */
-static uint64_t time_buttons[NUM_BUTTONS];
+/* Private type with the debounce filter of an input */
+typedef struct {
+    uint8_t state;  /* Debounced state, 1 = pressed */
+    uint8_t raw;    /* Last sampled level, 1 = pressed */
+    uint8_t count;  /* Consecutive samples read at level raw */
+    uint8_t active; /* Flag (0/1), sampled from the tick (always 1 for polled inputs) */
+} button_debounce_t;
+/* Private array with the debounce filter of each button */
+static volatile button_debounce_t buttonsDebounce[NUM_BUTTONS];
+
+/* Private type with the vertical counters of the inputs of a port */
+typedef struct {
+    volatile const uint8_t *in;             /* PxIN register of the port */
+    uint8_t mask;                           /* Pins of the port used as inputs */
+    uint8_t state;                          /* Debounced state, bit = 1 if pressed */
+    uint8_t ct0;                            /* Bit 0 of the vertical counters */
+    uint8_t ct1;                            /* Bit 1 of the vertical counters */
+    int8_t pin_button[PINS_PER_PORT];       /* Button index of each pin (BUTTON_NONE if unused) */
+} button_port_t;
+/* Private arrays with the edge capture of the use_capture inputs */
+static volatile button_capture_t buttonsCapture[NUM_BUTTONS];
+static volatile uint8_t buttonsCaptureLow[NUM_BUTTONS];   /* Current level, 1 = low */
+
+/* Private type with a handler registered with buttonOnEvent */
+typedef struct {
+    volatile uint8_t event_mask;    /* BUTTON_EVENT_MASK() of the events to deliver, 0 = free slot */
+    button_handler_t fn;
+    void *ctx;
+} button_handler_slot_t;
+/* Private table of registered handlers, a row per button */
+static button_handler_slot_t buttonsHandlers[NUM_BUTTONS][BUTTONS_HANDLERS_PER_INPUT];
+
+/* Private array with the ports used by buttonsPinRef, built in buttonsInit */
+static button_port_t buttonsPorts[NUM_BUTTONS];
+static uint8_t buttonsNumPorts;
+/* Private dispatch table: button index of each pin of each port (BUTTON_NONE if unused).
+   Indexed by [INT_PORTx - INT_PORT1][(PxIV >> 1) - 1], built in buttonsInit */
+static int8_t buttonsIVTable[NUM_INT_PORTS][PINS_PER_PORT];
 
 /* ----------- Definition of private variables (with static) -------------- */
+/* Settle times in ticks (milliseconds) */
+static uint8_t buttonsPressSettle = BUTTONS_PRESS_SETTLE_MS;
+static uint8_t buttonsReleaseSettle = BUTTONS_RELEASE_SETTLE_MS;
+/* Flag (0/1), the tick must not touch the filters before buttonsInit */
+static volatile uint8_t buttonsReady;
+/* Vertical counters: ticks between samples, and ticks to the next sample */
+static uint8_t buttonsSamplePeriod = (BUTTONS_RELEASE_SETTLE_MS + 3) / 4;
+static uint8_t buttonsSampleCount;
 
 /* ----------------- Definition of public variables --------------------- */
 
 /* ---------- Declaration of private functions (with static) -------------- */
 
-/* A function that returns the bitmask for a specific port */
-static int _IVBitmask(int port);
 static void _buttonInit(const input_pinref_t *ref);
-static int _buttonInverseSearch(uint16_t int_num, uint8_t mask);
+static void _buttonsIVTableInit(void);
+static int _buttonFromIV(uint8_t port, uint16_t iv);
+static void _buttonsPortIRQ(uint8_t port, volatile const uint16_t *iv_reg);
+static uint8_t _buttonRaw(const input_pinref_t *ref);
+static void _buttonArm(const input_pinref_t *ref, uint8_t pressed);
+static void _buttonDisarm(const input_pinref_t *ref);
+static void _buttonDebounce(uint8_t i);
+static volatile const uint8_t *_buttonIn(const input_pinref_t *ref);
+static void _buttonsPortsInit(void);
+static void _buttonsPortDebounce(button_port_t *port);
+static void _buttonCapture(uint8_t i);
+static void _buttonEmit(uint8_t i, button_event_t event);
 
 
 /* --------- Implementation of private functions (with static) ------------ */
-static int _IVBitmask(int port){
-    switch(port){
-    case 0x00:
-        return -1;
-        break;
-    case 0x02:
-        return BIT0;
-        break;
-    case 0x04:
-        return BIT1;
-        break;
-    case 0x06:
-        return BIT2;
-        break;
-    case 0x08:
-        return BIT3;
-        break;
-    case 0x0A:
-        return BIT4;
-        break;
-    case 0x0C:
-        return BIT5;
-        break;
-    case 0x0E:
-        return BIT6;
-        break;
-    case 0x10:
-        return BIT7;
-        break;
-    default:
-        return -1;
-        break;
-    }
-}
-
 static void _buttonInit(const input_pinref_t *ref)
 {
     if (ref->port_is_odd)
@@ -99,7 +155,7 @@ static void _buttonInit(const input_pinref_t *ref)
         if(ref->use_interrupt)
         {
             ref->odd->IES |= ref->mask;
-            ref->odd->IE |= ref->mask;
+            ref->odd->IE &= ~(ref->mask);    /* Armed by the debounce filter */
             ref->odd->IFG &= ~(ref->mask);
             Interrupt_enableInterrupt(ref->int_num);
         }
@@ -117,107 +173,383 @@ static void _buttonInit(const input_pinref_t *ref)
         if(ref->use_interrupt)
         {
             ref->even->IES |= ref->mask;
-            ref->even->IE |= ref->mask;
+            ref->even->IE &= ~(ref->mask);    /* Armed by the debounce filter */
             ref->even->IFG &= ~(ref->mask);
             Interrupt_enableInterrupt(ref->int_num);
         }
     }
 }
 
-static int _buttonInverseSearch(uint16_t int_num, uint8_t mask)
+static void _buttonsIVTableInit(void)
 {
-    int i;
-    for(i = 0; i < NUM_BUTTONS; i++){
-        if((buttonsPinRef[i].int_num == int_num) && (buttonsPinRef[i].mask == mask))
-            return i;
+    uint8_t i, port, pin;
+    for (port = 0; port < NUM_INT_PORTS; port++)
+    {
+        for (pin = 0; pin < PINS_PER_PORT; pin++)
+        {
+            buttonsIVTable[port][pin] = BUTTON_NONE;
+        }
+    }
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (buttonsPinRef[i].use_interrupt)
+        {
+            port = buttonsPinRef[i].int_num - INT_PORT1;
+            for (pin = 0; pin < PINS_PER_PORT; pin++)
+            {
+                if (buttonsPinRef[i].mask & (1 << pin))
+                {
+                    buttonsIVTable[port][pin] = i;
+                }
+            }
+        }
     }
-    return -1;
 }
 
-void PORT1_IRQHandler(void){
-    uint16_t int_num = INT_PORT1;
-    uint16_t port = P1->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+/* PxIV is 0 (no interrupt pending) or 2 * (pin + 1) */
+static int _buttonFromIV(uint8_t port, uint16_t iv)
+{
+    if (iv == 0)
+    {
+        return BUTTON_NONE;
+    }
+    return buttonsIVTable[port][(iv >> 1) - 1];
+}
+
+/* Shared body of the port handlers. Every read of PxIV clears the flag it reports,
+   so looping until it reads 0 serves all the pins pending on the port in one exception */
+static void _buttonsPortIRQ(uint8_t port, volatile const uint16_t *iv_reg)
+{
+    uint16_t iv;
+    int button_num;
+    while ((iv = BUTTONS_READ_IV(iv_reg)) != 0)
+    {
+        button_num = _buttonFromIV(port, iv);
+        if(button_num == BUTTON_NONE){
+            continue;
+        }
+        if(buttonsPinRef[button_num].use_capture){
+            _buttonCapture(button_num);
+        }else{
+            /* Ignore the bounces, the filter takes it from here */
+            _buttonDisarm(&buttonsPinRef[button_num]);
+            buttonsDebounce[button_num].active = 1;
         }
     }
 }
-void PORT2_IRQHandler(void){
-    uint16_t int_num = INT_PORT2;
-    uint16_t port = P2->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+
+/* Timestamp the edge that fired and arm the opposite one. PxIES is flipped only after
+   the edge, so the pin is read again once armed: an edge that came in between would
+   not have set PxIFG, and it is recorded here instead */
+static void _buttonCapture(uint8_t i)
+{
+    const input_pinref_t *ref = &buttonsPinRef[i];
+    volatile button_capture_t *cap = &buttonsCapture[i];
+    uint32_t now = DWT->CYCCNT;
+    uint8_t low = !buttonsCaptureLow[i];    /* The edge that fired leaves the recorded level */
+
+    while (1)
+    {
+        if (low)
+        {
+            cap->high_cycles = now - cap->rise_cycles;
+            cap->fall_cycles = now;
+        }
+        else
+        {
+            cap->low_cycles = now - cap->fall_cycles;
+            cap->rise_cycles = now;
         }
+        cap->edges++;
+        buttonsCaptureLow[i] = low;
+        _buttonArm(ref, low);
+        if (_buttonRaw(ref) == low)
+        {
+            break;
+        }
+        now = DWT->CYCCNT;
+        low = !low;
     }
 }
-void PORT3_IRQHandler(void){
-    uint16_t int_num = INT_PORT3;
-    uint16_t port = P3->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+
+/* Deliver a debounced event: straight to the handlers registered for this button,
+   then to the global callback */
+static void _buttonEmit(uint8_t i, button_event_t event)
+{
+    uint8_t k;
+    uint8_t bit = BUTTON_EVENT_MASK(event);
+    button_handler_slot_t *h = buttonsHandlers[i];
+    for (k = 0; k < BUTTONS_HANDLERS_PER_INPUT; k++, h++)
+    {
+        if (h->event_mask & bit)
+        {
+            h->fn(i, event, h->ctx);
         }
     }
+    buttonEventCallback(i, event);
 }
-void PORT4_IRQHandler(void){
-    uint16_t int_num = INT_PORT4;
-    uint16_t port = P4->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+
+/* Buttons are active low: 1 if the pin reads 0 */
+static uint8_t _buttonRaw(const input_pinref_t *ref)
+{
+    if (ref->port_is_odd)
+    {
+        return (ref->odd->IN & ref->mask) ? 0 : 1;
+    }
+    else
+    {
+        return (ref->even->IN & ref->mask) ? 0 : 1;
+    }
+}
+
+/* Wait for the edge leaving the given state: falling if released, rising if pressed.
+   Writing PxIES can set PxIFG, so the flag is cleared afterwards */
+static void _buttonArm(const input_pinref_t *ref, uint8_t pressed)
+{
+    if (ref->port_is_odd)
+    {
+        if (pressed)
+            ref->odd->IES &= ~(ref->mask);
+        else
+            ref->odd->IES |= ref->mask;
+        ref->odd->IFG &= ~(ref->mask);
+        ref->odd->IE |= ref->mask;
+    }
+    else
+    {
+        if (pressed)
+            ref->even->IES &= ~(ref->mask);
+        else
+            ref->even->IES |= ref->mask;
+        ref->even->IFG &= ~(ref->mask);
+        ref->even->IE |= ref->mask;
+    }
+}
+
+static void _buttonDisarm(const input_pinref_t *ref)
+{
+    if (ref->port_is_odd)
+    {
+        ref->odd->IE &= ~(ref->mask);
+    }
+    else
+    {
+        ref->even->IE &= ~(ref->mask);
+    }
+}
+
+/* One sample of the integrator of button i */
+static void _buttonDebounce(uint8_t i)
+{
+    const input_pinref_t *ref = &buttonsPinRef[i];
+    volatile button_debounce_t *db = &buttonsDebounce[i];
+    uint8_t raw = _buttonRaw(ref);
+    uint8_t settle;
+
+    if (raw != db->raw)
+    {
+        db->raw = raw;
+        db->count = 0;
+    }
+    if (db->count < 0xFF)
+    {
+        db->count++;
+    }
+    settle = raw ? buttonsPressSettle : buttonsReleaseSettle;
+    if (db->count < settle)
+    {
+        return;
+    }
+    if (raw != db->state)
+    {
+        db->state = raw;
+        _buttonEmit(i, raw ? BUTTON_EVENT_PRESS : BUTTON_EVENT_RELEASE);
+    }
+    if (ref->use_interrupt)
+    {
+        /* Settled: go back to sleep until the next edge */
+        db->active = 0;
+        _buttonArm(ref, db->state);
+        if (_buttonRaw(ref) != db->state)
+        {
+            /* The edge came while arming, keep sampling */
+            _buttonDisarm(ref);
+            db->active = 1;
         }
     }
 }
-void PORT5_IRQHandler(void){
-    uint16_t int_num = INT_PORT5;
-    uint16_t port = P5->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+
+static volatile const uint8_t *_buttonIn(const input_pinref_t *ref)
+{
+    if (ref->port_is_odd)
+    {
+        return &(ref->odd->IN);
+    }
+    else
+    {
+        return &(ref->even->IN);
+    }
+}
+
+/* Group the inputs of buttonsPinRef by port */
+static void _buttonsPortsInit(void)
+{
+    uint8_t i, g, pin;
+    volatile const uint8_t *in;
+    buttonsNumPorts = 0;
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (buttonsPinRef[i].use_capture)
+        {
+            continue;
+        }
+        in = _buttonIn(&buttonsPinRef[i]);
+        for (g = 0; g < buttonsNumPorts; g++)
+        {
+            if (buttonsPorts[g].in == in)
+            {
+                break;
+            }
+        }
+        if (g == buttonsNumPorts)
+        {
+            buttonsPorts[g].in = in;
+            buttonsPorts[g].mask = 0;
+            for (pin = 0; pin < PINS_PER_PORT; pin++)
+            {
+                buttonsPorts[g].pin_button[pin] = BUTTON_NONE;
+            }
+            buttonsNumPorts++;
+        }
+        buttonsPorts[g].mask |= buttonsPinRef[i].mask;
+        for (pin = 0; pin < PINS_PER_PORT; pin++)
+        {
+            if (buttonsPinRef[i].mask & (1 << pin))
+            {
+                buttonsPorts[g].pin_button[pin] = i;
+            }
         }
     }
+    for (g = 0; g < buttonsNumPorts; g++)
+    {
+        /* Counters idle at 3, start from the current levels */
+        buttonsPorts[g].state = ~(*buttonsPorts[g].in) & buttonsPorts[g].mask;
+        buttonsPorts[g].ct0 = 0xFF;
+        buttonsPorts[g].ct1 = 0xFF;
+    }
 }
-void PORT6_IRQHandler(void){
-    uint16_t int_num = INT_PORT6;
-    uint16_t port = P6->IV;
-    int bitmask = _IVBitmask(port);
-    int button_num = _buttonInverseSearch(int_num,bitmask);
-    if(button_num > 0){
-        if((stimeElapsedMillis() - time_buttons[button_num]) > 100){
-            time_buttons[button_num] = stimeElapsedMillis();
-            buttonCallback(button_num);
+
+/* One sample of the eight vertical counters of a port. A counter is reloaded with 3 while
+   its pin agrees with the debounced state and counts down while it differs; the state bit
+   toggles when it rolls over, i.e. after four equal samples */
+static void _buttonsPortDebounce(button_port_t *port)
+{
+    uint8_t delta, toggle, pin;
+
+    delta = (~(*port->in) & port->mask) ^ port->state;
+    port->ct0 = ~(port->ct0 & delta);
+    port->ct1 = port->ct0 ^ (port->ct1 & delta);
+    toggle = delta & port->ct0 & port->ct1;
+    port->state ^= toggle;
+
+    /* Only pins that toggled reach the per pin code */
+    for (pin = 0; toggle != 0; pin++, toggle >>= 1)
+    {
+        if (toggle & 1)
+        {
+            _buttonEmit(port->pin_button[pin],
+                                (port->state & (1 << pin)) ? BUTTON_EVENT_PRESS : BUTTON_EVENT_RELEASE);
+        }
+    }
+}
+
+/* Definition of the tick callback of the stime module in this module */
+void stimeTickCallback(void)
+{
+    uint8_t i;
+    if (!buttonsReady)
+    {
+        return;
+    }
+#if BUTTONS_DEBOUNCE_VERTICAL
+    if (++buttonsSampleCount < buttonsSamplePeriod)
+    {
+        return;
+    }
+    buttonsSampleCount = 0;
+    for (i = 0; i < buttonsNumPorts; i++)
+    {
+        _buttonsPortDebounce(&buttonsPorts[i]);
+    }
+#else
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (buttonsDebounce[i].active)
+        {
+            _buttonDebounce(i);
         }
     }
+#endif
+}
+
+void PORT1_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT1 - INT_PORT1, &(P1->IV));
+}
+void PORT2_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT2 - INT_PORT1, &(P2->IV));
+}
+void PORT3_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT3 - INT_PORT1, &(P3->IV));
+}
+void PORT4_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT4 - INT_PORT1, &(P4->IV));
+}
+void PORT5_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT5 - INT_PORT1, &(P5->IV));
+}
+void PORT6_IRQHandler(void){
+    _buttonsPortIRQ(INT_PORT6 - INT_PORT1, &(P6->IV));
 }
 
 /* ---------------- Implementation of public functions ------------------ */
 void buttonsInit()
 {
     uint8_t i;
+    buttonsReady = 0;
+    /* Cycle counter used to timestamp the captured edges */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    _buttonsIVTableInit();
     for (i = 0; i < NUM_BUTTONS; i++)
     {
         _buttonInit(&(buttonsPinRef[i]));
-        if(buttonsPinRef[i].use_interrupt){
-            time_buttons[i] = stimeElapsedMillis();
+        /* Start from the current level, the first samples arm the interrupts */
+        buttonsDebounce[i].state = _buttonRaw(&(buttonsPinRef[i]));
+        buttonsDebounce[i].raw = buttonsDebounce[i].state;
+        buttonsDebounce[i].count = 0;
+        /* With vertical counters the pins are never armed, all ports are sampled */
+        buttonsDebounce[i].active = !BUTTONS_DEBOUNCE_VERTICAL;
+        if (buttonsPinRef[i].use_capture)
+        {
+            buttonsDebounce[i].active = 0;
+            buttonsCaptureLow[i] = buttonsDebounce[i].state;
+            _buttonArm(&(buttonsPinRef[i]), buttonsCaptureLow[i]);
         }
     }
+    _buttonsPortsInit();
+    buttonsReady = 1;
+}
+
+void buttonsSetSettleMillis(uint8_t press_ms, uint8_t release_ms)
+{
+    buttonsPressSettle = press_ms > 0 ? press_ms : 1;
+    buttonsReleaseSettle = release_ms > 0 ? release_ms : 1;
+    /* Vertical counters need four samples, press and release share the longest time */
+    buttonsSamplePeriod = ((press_ms > release_ms ? press_ms : release_ms) + 3) / 4;
+    if (buttonsSamplePeriod == 0)
+    {
+        buttonsSamplePeriod = 1;
+    }
 }
 
 button_val_t buttonGet(button_ref_t button_ref)
@@ -246,7 +578,74 @@ int buttonsGetNum(void)
     return NUM_BUTTONS;
 }
 
+int buttonOnEvent(button_ref_t button_ref, uint8_t event_mask, button_handler_t fn, void *ctx)
+{
+    uint8_t k;
+    button_handler_slot_t *h, *free_slot = 0;
+    if ((button_ref >= NUM_BUTTONS) || (fn == 0))
+    {
+        return -1;
+    }
+    for (k = 0; k < BUTTONS_HANDLERS_PER_INPUT; k++)
+    {
+        h = &buttonsHandlers[button_ref][k];
+        if ((h->event_mask != 0) && (h->fn == fn) && (h->ctx == ctx))
+        {
+            /* Already registered: new mask (0 removes it) */
+            h->event_mask = event_mask;
+            return 0;
+        }
+        if ((h->event_mask == 0) && (free_slot == 0))
+        {
+            free_slot = h;
+        }
+    }
+    if (event_mask == 0)
+    {
+        return 0;
+    }
+    if (free_slot == 0)
+    {
+        return -1;
+    }
+    /* The mask goes last: the tick ignores the slot until it is complete */
+    free_slot->fn = fn;
+    free_slot->ctx = ctx;
+    free_slot->event_mask = event_mask;
+    return 0;
+}
+
+int buttonGetCapture(button_ref_t button_ref, button_capture_t *cap)
+{
+    uint32_t edges;
+    if ((button_ref >= NUM_BUTTONS) || !buttonsPinRef[button_ref].use_capture)
+    {
+        return 0;
+    }
+    /* Copy again if an edge was captured while copying */
+    do
+    {
+        edges = buttonsCapture[button_ref].edges;
+        cap->rise_cycles = buttonsCapture[button_ref].rise_cycles;
+        cap->fall_cycles = buttonsCapture[button_ref].fall_cycles;
+        cap->high_cycles = buttonsCapture[button_ref].high_cycles;
+        cap->low_cycles = buttonsCapture[button_ref].low_cycles;
+        cap->edges = edges;
+    } while (edges != buttonsCapture[button_ref].edges);
+    return 1;
+}
+
 void buttonCallback(int button_index) __attribute__((weak));
 void buttonCallback(int button_index){}
 
+/* The default event callback keeps the press-only buttonCallback working */
+void buttonEventCallback(int button_index, button_event_t event) __attribute__((weak));
+void buttonEventCallback(int button_index, button_event_t event)
+{
+    if (event == BUTTON_EVENT_PRESS)
+    {
+        buttonCallback(button_index);
+    }
+}
+
 /* @} */
@@ -11,6 +11,12 @@
  *The public function buttons_init intializes the hardware for the buttons to be used.
  *The public function buttonGet() takes a button_ref_t parameter as input to return the state of this button.
  *The public function buttonsGetNum() returns an integer containing the amount of buttons on this board.
+ *The public function buttonsSetSettleMillis() sets how long a level must be stable before a press or release is reported.
+ *The callback buttonEventCallback() receives the debounced press and release events (its default calls buttonCallback() on press).
+ *Both callbacks run from the 1 ms stime tick, not from the port interrupt handlers.
+ *The public function buttonOnEvent() registers a handler (with a context pointer) for some events of one button,
+ *so each module gets its own inputs without going through a central callback.
+ *The public function buttonGetCapture() returns the edge timestamps and pulse widths of an input configured with use_capture.
  *
  * @{
  */
@@ -25,6 +31,19 @@
 #include "stime.h"
 
 /* --------------------------- Public macros ----------------------------- */
+#define BUTTONS_PRESS_SETTLE_MS   10  /* Default time the pin must read pressed to report a press */
+#define BUTTONS_RELEASE_SETTLE_MS 20  /* Default time the pin must read released to report a release */
+#define BUTTONS_HANDLERS_PER_INPUT 2   /* Handlers that can be registered on each button */
+#define BUTTON_EVENT_MASK(e) (1 << (e)) /* Bit of a button_event_t in the buttonOnEvent mask */
+#ifndef BUTTONS_DEBOUNCE_VERTICAL
+#define BUTTONS_DEBOUNCE_VERTICAL 0   /* 1: debounce whole ports with vertical counters (many inputs) */
+#endif
+#ifndef BUTTONS_BENCH_INPUTS
+#define BUTTONS_BENCH_INPUTS 0        /* 16 or 48: whole ports P1.. as inputs instead of the board buttons (bench.c) */
+#endif
+#ifndef BUTTONS_BENCH_INTERRUPT
+#define BUTTONS_BENCH_INTERRUPT 0     /* 1: the bench inputs use the port interrupts, 0: they are polled */
+#endif
 /* ----------------------- Public data types ------------------------- */
     /* Enumeration of the status values of a button */
 typedef enum button_val_e {BUTTON_PRESSED, BUTTON_RELEASED} button_val_t ;
@@ -36,6 +55,18 @@ LP_S2 , /* LaunchPad , button S2 */
 BP_S1 , /* BoosterPack , button S1 */
 BP_S2 /* BoosterPack , button S2 */
 } button_ref_t ;
+    /* Enumeration of the debounced events of a button */
+typedef enum button_event_e {BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE} button_event_t ;
+    /* Handler registered with buttonOnEvent, ctx is the pointer given at registration */
+typedef void (*button_handler_t)(int button_index, button_event_t event, void *ctx);
+    /* Edge capture of an input with use_capture (times in CPU cycles, DWT->CYCCNT) */
+typedef struct {
+    uint32_t rise_cycles;   /* Timestamp of the last rising edge */
+    uint32_t fall_cycles;   /* Timestamp of the last falling edge */
+    uint32_t high_cycles;   /* Width of the last high pulse */
+    uint32_t low_cycles;    /* Width of the last low pulse (hold time of an active low button) */
+    uint32_t edges;         /* Number of edges captured */
+} button_capture_t ;
 
 
 /* ---- Declaration of public variables (no definition, use extern) ----- */
@@ -44,7 +75,11 @@ BP_S2 /* BoosterPack , button S2 */
 void buttonsInit(void);
 button_val_t buttonGet(button_ref_t button_ref);
 int buttonsGetNum(void);
+void buttonsSetSettleMillis(uint8_t press_ms, uint8_t release_ms);
+int buttonOnEvent(button_ref_t button_ref, uint8_t event_mask, button_handler_t fn, void *ctx);
+int buttonGetCapture(button_ref_t button_ref, button_capture_t *cap);
 extern void buttonCallback(int button_index);
+extern void buttonEventCallback(int button_index, button_event_t event);
 
 /* @} */
 
@@ -49,6 +49,7 @@ typedef struct output_ref_s output_ref_t;
     - whether an internal pull-up resistor is required in the configuration (use_pullup field).
     - whether interrupts are used or not (use_interrupt field).
     - the interupt number (int_num field).
+    - whether both edges are timestamped instead of debounced (use_capture field).
  @note Only values INT_PORT1 to INT_PORT6 (declared in driverlib's interrupt.h header file)
  are expected to be used in the int_num field.
  @remarks Only one the the odd and even pointers can be used per pin reference
@@ -63,6 +64,9 @@ struct input_ref_s {
                                 managed using polling or interrupts         */
    uint16_t int_num;       /**< Interrupt number (INT_PORT1 to INT_PORT6),
                                 used only if use_interrupt == 1.            */
+   uint8_t  use_capture;   /**< Flag (0/1) to timestamp both edges in the
+                                interrupt handler instead of debouncing.
+                                Requires use_interrupt == 1.                */
    union {
       DIO_PORT_Odd_Interruptable_Type  *odd;  /**< Use this in case the port
                                                    has an odd number:
@@ -0,0 +1,182 @@
+/**
+ * @file gesture.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief A source file for the gesture module.
+ *
+ *  A source file with the implementation for the private and public functions for the gesture module.
+ *  Each button runs a small state machine fed by the debounced edges and by a periodic tick.
+ *  The event ring is lock-free: only the producer (tick context) writes queueHead and only the
+ *  consumer (application) writes queueTail, each index is written after the slot it publishes or frees.
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include "gesture.h"
+
+/* --------------------------- Private macros ----------------------------- */
+#define QUEUE_MASK (GESTURE_QUEUE_LEN - 1)
+
+/* ----------------------- Private data types ------------------------- */
+/* Private type with the state of a button */
+typedef enum {
+    GST_IDLE,       /* Released, no click pending */
+    GST_CLICKED,    /* Released after a short press, a second press would be a double click */
+    GST_HELD        /* Pressed */
+} gesture_state_t;
+
+typedef struct {
+    uint8_t state;          /* gesture_state_t */
+    uint8_t long_sent;      /* Flag (0/1), GESTURE_LONG_PRESS already sent for this press */
+    uint32_t press_ms;      /* Time of the last press */
+    uint32_t release_ms;    /* Time of the last release */
+    uint32_t repeat_ms;     /* Time of the next GESTURE_REPEAT */
+} gesture_button_t;
+
+/* ----------- Definition of private variables (with static) -------------- */
+static gesture_button_t gestureButtons[GESTURE_MAX_BUTTONS];
+static gesture_event_t gestureQueue[GESTURE_QUEUE_LEN];
+static volatile uint8_t queueHead;      /* Next slot to write, producer only */
+static volatile uint8_t queueTail;      /* Next slot to read, consumer only */
+static volatile uint32_t queueDropped;
+
+/* ----------------- Definition of public variables --------------------- */
+
+/* ---------- Declaration of private functions (with static) -------------- */
+static void _gesturePush(uint8_t button, gesture_type_t type, uint32_t time_ms, uint32_t hold_ms);
+static void _gestureHandler(int button_index, button_event_t event, void *ctx);
+
+/* --------- Implementation of private functions (with static) ------------ */
+static void _gesturePush(uint8_t button, gesture_type_t type, uint32_t time_ms, uint32_t hold_ms)
+{
+    uint8_t head = queueHead;
+    gesture_event_t *ev;
+
+    if (((head - queueTail) & 0xFF) >= GESTURE_QUEUE_LEN)
+    {
+        queueDropped++;
+        return;
+    }
+    ev = &gestureQueue[head & QUEUE_MASK];
+    ev->button = button;
+    ev->type = type;
+    ev->time_ms = time_ms;
+    ev->hold_ms = hold_ms;
+    /* Publish the slot only once it is complete: the barrier keeps the compiler
+       (and the bus) from moving the slot stores after the index store */
+    __DMB();
+    queueHead = head + 1;
+}
+
+/* Handler registered on every button with buttonOnEvent */
+static void _gestureHandler(int button_index, button_event_t event, void *ctx)
+{
+    gestureFeed(button_index, event);
+}
+
+/* ---------------- Implementation of public functions ------------------ */
+void gestureInit(void)
+{
+    uint8_t i;
+    for (i = 0; i < GESTURE_MAX_BUTTONS; i++)
+    {
+        gestureButtons[i].state = GST_IDLE;
+        gestureButtons[i].long_sent = 0;
+    }
+    queueHead = 0;
+    queueTail = 0;
+    queueDropped = 0;
+    for (i = 0; (i < GESTURE_MAX_BUTTONS) && (i < buttonsGetNum()); i++)
+    {
+        buttonOnEvent((button_ref_t)i, BUTTON_EVENT_MASK(BUTTON_EVENT_PRESS) | BUTTON_EVENT_MASK(BUTTON_EVENT_RELEASE),
+                      _gestureHandler, 0);
+    }
+}
+
+void gestureFeed(int button_index, button_event_t event)
+{
+    gesture_button_t *b;
+    uint32_t now;
+
+    if (button_index < 0 || button_index >= GESTURE_MAX_BUTTONS)
+    {
+        return;
+    }
+    b = &gestureButtons[button_index];
+    now = (uint32_t)stimeElapsedMillis();
+
+    if (event == BUTTON_EVENT_PRESS)
+    {
+        _gesturePush(button_index, GESTURE_PRESS, now, 0);
+        if ((b->state == GST_CLICKED) && ((now - b->release_ms) <= GESTURE_DOUBLE_MS))
+        {
+            _gesturePush(button_index, GESTURE_DOUBLE_CLICK, now, 0);
+        }
+        b->state = GST_HELD;
+        b->press_ms = now;
+        b->long_sent = 0;
+    }
+    else if (b->state == GST_HELD)
+    {
+        _gesturePush(button_index, GESTURE_RELEASE, now, now - b->press_ms);
+        /* A long press does not count as the first click of a double click */
+        b->state = b->long_sent ? GST_IDLE : GST_CLICKED;
+        b->release_ms = now;
+    }
+}
+
+void gestureTick(void)
+{
+    uint8_t i;
+    gesture_button_t *b;
+    uint32_t now = (uint32_t)stimeElapsedMillis();
+
+    for (i = 0; i < GESTURE_MAX_BUTTONS; i++)
+    {
+        b = &gestureButtons[i];
+        if (b->state != GST_HELD)
+        {
+            continue;
+        }
+        if (!b->long_sent)
+        {
+            if ((now - b->press_ms) >= GESTURE_LONG_MS)
+            {
+                _gesturePush(i, GESTURE_LONG_PRESS, now, now - b->press_ms);
+                b->long_sent = 1;
+                b->repeat_ms = now + GESTURE_REPEAT_MS;
+            }
+        }
+        else if ((int32_t)(now - b->repeat_ms) >= 0)
+        {
+            _gesturePush(i, GESTURE_REPEAT, now, now - b->press_ms);
+            b->repeat_ms += GESTURE_REPEAT_MS;
+        }
+    }
+}
+
+int gestureGet(gesture_event_t *ev)
+{
+    uint8_t tail = queueTail;
+
+    if (tail == queueHead)
+    {
+        return 0;
+    }
+    /* No slot read before the index read */
+    __DMB();
+    *ev = gestureQueue[tail & QUEUE_MASK];
+    /* Free the slot only once it has been copied */
+    __DMB();
+    queueTail = tail + 1;
+    return 1;
+}
+
+uint32_t gestureGetDropped(void)
+{
+    return queueDropped;
+}
+
+/* @} */
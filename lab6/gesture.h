@@ -0,0 +1,70 @@
+/**
+ * @file gesture.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Header file with declaration of public data types and variables for the gesture module.
+ *
+ *A header file to be used by the user to get typed, timestamped button events.
+ *The gesture module turns the debounced press/release edges of the buttons module into
+ *press, release, long-press, double-click and repeat-while-held events.
+ *Events are stored in a lock-free ring (single producer: the tick, single consumer: the application),
+ *so the application drains them at its own pace with gestureGet() and the interrupts never wait for it.
+ *
+ *gestureInit() registers the module on the press and release events of every button (buttonOnEvent).
+ *The application only has to call gestureTick() every GESTURE_TICK_MS,
+ *e.g. from stimeCallback() with stimeExecMillis(GESTURE_TICK_MS).
+ *
+ * @{
+ */
+#ifndef __GESTURE_H
+#define __GESTURE_H
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdint.h>
+#include "buttons.h"
+#include "stime.h"
+
+/* --------------------------- Public macros ----------------------------- */
+#define GESTURE_TICK_MS         10   /* Expected period of gestureTick() */
+#define GESTURE_LONG_MS         800  /* Hold time to report a long press */
+#define GESTURE_DOUBLE_MS       300  /* Max time between a release and the next press for a double click */
+#define GESTURE_REPEAT_MS       150  /* Repeat period while held after a long press */
+#define GESTURE_QUEUE_LEN       16   /* Events in the ring, must be a power of two */
+#define GESTURE_MAX_BUTTONS     8    /* Buttons tracked by the module */
+
+/* ----------------------- Public data types ------------------------- */
+    /* Enumeration of the event types */
+typedef enum gesture_type_e {
+GESTURE_PRESS ,         /* Button pressed */
+GESTURE_RELEASE ,       /* Button released, hold_ms is the press duration */
+GESTURE_LONG_PRESS ,    /* Button held GESTURE_LONG_MS */
+GESTURE_DOUBLE_CLICK ,  /* Second press shortly after a short click */
+GESTURE_REPEAT          /* Button still held after a long press, every GESTURE_REPEAT_MS */
+} gesture_type_t ;
+
+    /* Event delivered to the application */
+typedef struct {
+    uint8_t button;     /* Button index (button_ref_t) */
+    uint8_t type;       /* gesture_type_t */
+    uint32_t time_ms;   /* Time of the event, from stimeElapsedMillis() */
+    uint32_t hold_ms;   /* Time the button has been held (0 for GESTURE_PRESS) */
+} gesture_event_t ;
+
+/* ---- Declaration of public variables (no definition, use extern) ----- */
+
+/* -------- Declaration of public functions (optional extern) ------------ */
+// Initialize the module (empty queue, all buttons released) and register it on the buttons
+void gestureInit(void);
+// Feed a debounced edge of the buttons module (tick context)
+void gestureFeed(int button_index, button_event_t event);
+// Generate the timed events (long press, repeat). Call every GESTURE_TICK_MS (tick context)
+void gestureTick(void);
+// Take the oldest event. Returns 1 if an event was copied to *ev, 0 if the queue is empty
+int gestureGet(gesture_event_t *ev);
+// Number of events lost because the queue was full
+uint32_t gestureGetDropped(void);
+
+/* @} */
+
+#endif // __GESTURE_H
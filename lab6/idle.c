@@ -0,0 +1,200 @@
+/**
+ * @file idle.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief A source file for the idle governor.
+ *
+ * The decision and the sleep happen in a critical section: an interrupt arriving in between
+ * stays pending and WFI returns at once, it is never lost. It is served when idleEnter()
+ * leaves the section.
+ * Tickless sleeps are woken by the RTC prescaler 1 interrupt, the largest interval (15.625 ms
+ * to 1 s) within the deadline. The interrupt is periodic, so the first one comes no later than
+ * the interval. The time slept is the difference of the 16 bits RTCPS (32768 Hz, wraps every
+ * 2 s), the part of the tick already elapsed when SysTick stopped is added to it, and what is
+ * below one millisecond is carried to the next sleep.
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "idle.h"
+#include "stick.h"
+#include "stime.h"
+#include "critical.h"
+
+/* --------------------------- Private macros ----------------------------- */
+#define IDLE_RTC_SHIFT 15       /* RTCPS counts 2^15 per second */
+#define IDLE_RT1IP_MAX 6        /* 1 s, the longest interval RTCPS can measure twice over */
+
+/* ----------------------- Private data types ------------------------- */
+
+/* ----------- Definition of private variables (with static) -------------- */
+static uint32_t idleLatency;                /* Wake-up latency budget (us) */
+static volatile uint8_t idleDeepLocks;      /* Deep sleep locks held */
+static volatile uint8_t idleTickLocks;      /* Tickless locks held */
+static uint32_t idleCarry;                  /* Time slept not yet given to stime (2^-15 ms) */
+
+/* ----------------- Definition of public variables --------------------- */
+
+/* ---------- Declaration of private functions (with static) -------------- */
+static uint16_t _idleReadPs(void);
+static void _idleTickless(idle_mode_t mode, uint32_t deadline, uint8_t ticking);
+void RTC_C_IRQHandler(void);
+
+/* --------- Implementation of private functions (with static) ------------ */
+
+/* RTCPS runs asynchronously to the CPU: two equal reads in a row are not in the middle of a carry */
+static uint16_t _idleReadPs(void)
+{
+    uint16_t ps;
+    do
+    {
+        ps = RTC_C->PS;
+    } while (ps != RTC_C->PS);
+    return ps;
+}
+
+/* Sleep with the tick stopped, woken by the RTC within deadline milliseconds */
+static void _idleTickless(idle_mode_t mode, uint32_t deadline, uint8_t ticking)
+{
+    uint16_t ps0, ps1;
+    uint32_t ip = 0, done;
+
+    if (ticking)
+    {
+        stickStop();
+        /* Part of the current tick already elapsed, in 2^-15 ms */
+        done = stickGetPeriod() - 1 - stickGetCount();
+        idleCarry += (uint32_t)(((uint64_t)done * 32768000UL) / CS_getMCLK());
+    }
+    while ((ip < IDLE_RT1IP_MAX) && (((125UL << (ip + 1)) >> 3) <= deadline))
+    {
+        ip++;
+    }
+    /* Writing the flag to 0 drops a stale interrupt */
+    RTC_C->PS1CTL = (ip << RTC_C_PS1CTL_RT1IP_OFS) | RTC_C_PS1CTL_RT1PSIE;
+    ps0 = _idleReadPs();
+    if (mode == IDLE_LPM3)
+    {
+        PCM_gotoLPM3();
+    }
+    else
+    {
+        PCM_gotoLPM0();
+    }
+    ps1 = _idleReadPs();
+    RTC_C->PS1CTL = 0;
+
+    if (ticking)
+    {
+        idleCarry += (uint32_t)(uint16_t)(ps1 - ps0) * 1000UL;
+        stimeAdvance(idleCarry >> IDLE_RTC_SHIFT);
+        idleCarry &= (1UL << IDLE_RTC_SHIFT) - 1;
+        /* The next tick is a whole one, its start is already accounted */
+        stickResetCount();
+        stickStart();
+    }
+}
+
+/* Clears the prescaler 1 interrupt that ends a sleep */
+void RTC_C_IRQHandler(void)
+{
+    RTC_C->PS1CTL &= ~RTC_C_PS1CTL_RT1PSIFG;
+}
+
+/* ---------------- Implementation of public functions ------------------ */
+void idleInit(void)
+{
+    idleLatency = IDLE_LATENCY_DEFAULT_US;
+    idleDeepLocks = 0;
+    idleTickLocks = 0;
+    idleCarry = 0;
+
+    /* BCLK from REFO (32768 Hz), it keeps running in LPM3 */
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL1 |= CS_CTL1_SELB;
+    CS->KEY = 0;
+
+    RTC_C->CTL0 = (RTC_C->CTL0 & ~RTC_C_CTL0_KEY_MASK) | RTC_C_KEY;
+    RTC_C->CTL13 &= ~RTC_C_CTL13_HOLD;
+    RTC_C->CTL0 &= ~RTC_C_CTL0_KEY_MASK;    /* Lock */
+    RTC_C->PS1CTL = 0;
+    Interrupt_enableInterrupt(INT_RTC_C);
+}
+
+void idleSetLatency(uint32_t us)
+{
+    idleLatency = us;
+}
+
+void idleBlockDeep(void)
+{
+    critical_t s = criticalEnter();
+    idleDeepLocks++;
+    criticalExit(s);
+}
+
+void idleAllowDeep(void)
+{
+    critical_t s = criticalEnter();
+    if (idleDeepLocks)
+    {
+        idleDeepLocks--;
+    }
+    criticalExit(s);
+}
+
+void idleBlockTickless(void)
+{
+    critical_t s = criticalEnter();
+    idleTickLocks++;
+    criticalExit(s);
+}
+
+void idleAllowTickless(void)
+{
+    critical_t s = criticalEnter();
+    if (idleTickLocks)
+    {
+        idleTickLocks--;
+    }
+    criticalExit(s);
+}
+
+idle_mode_t idleEnter(void)
+{
+    idle_mode_t mode;
+    uint32_t deadline;
+    uint8_t ticking;
+    critical_t s;
+
+    s = criticalEnter();
+    ticking = (stickIsStarted() && stickIsIntEnabled()) ? 1 : 0;
+    deadline = stimeNextDeadline();
+    if (ticking && ((idleTickLocks != 0) || (deadline < IDLE_TICKLESS_MIN_MS)))
+    {
+        mode = IDLE_WFI;
+    }
+    else if ((idleDeepLocks == 0) && (idleLatency >= IDLE_LPM3_WAKE_US))
+    {
+        mode = IDLE_LPM3;
+    }
+    else
+    {
+        mode = IDLE_LPM0;
+    }
+    if (mode == IDLE_WFI)
+    {
+        __WFI();
+    }
+    else
+    {
+        _idleTickless(mode, deadline, ticking);
+    }
+    criticalExit(s);
+    return mode;
+}
+
+/* @} */
@@ -0,0 +1,61 @@
+/**
+ * @file idle.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Header file of the idle governor: sleep as deep as the next deadline and the wake-up
+ * latency budget allow.
+ *
+ *idleEnter() replaces the empty spin of the main loop. It sleeps until the next interrupt in one of three ways:
+ *IDLE_WFI, WFI with the 1 ms stime tick running, for deadlines closer than IDLE_TICKLESS_MIN_MS or while a
+ *module holds a tickless lock; IDLE_LPM0, tick stopped and clocks running, woken by the RTC no later than the
+ *next stime deadline; IDLE_LPM3, as IDLE_LPM0 with MCLK and SMCLK off as well, when no module holds a deep
+ *sleep lock and the latency budget covers the IDLE_LPM3_WAKE_US wake-up.
+ *The RTC (from REFO, 32768 Hz) keeps time while the tick is stopped, and stime is corrected with the time
+ *slept on every wake-up.
+ *Modules that need SMCLK or MCLK while the CPU sleeps (leds PWM) hold idleBlockDeep(), modules that work from
+ *every tick (polled buttons) hold idleBlockTickless().
+ *
+ * @{
+ */
+#ifndef __IDLE_H
+#define __IDLE_H
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdint.h>
+
+/* --------------------------- Public macros ----------------------------- */
+#define IDLE_LPM3_WAKE_US       25      /* LPM3 to active mode, DCO restart included (estimate, measure on the board) */
+#define IDLE_TICKLESS_MIN_MS    16      /* Shortest RTC wake-up interval (15.625 ms), rounded up */
+#define IDLE_LATENCY_DEFAULT_US 1000    /* Wake-up latency budget after idleInit() */
+
+/* ----------------------- Public data types ------------------------- */
+    /* Ways of sleeping, lightest first */
+typedef enum idle_mode_e {
+IDLE_WFI ,  /* Core asleep, tick running */
+IDLE_LPM0 , /* Core asleep, tick stopped, clocks running */
+IDLE_LPM3   /* Core asleep, tick stopped, only the RTC running */
+} idle_mode_t ;
+
+/* ---- Declaration of public variables (no definition, use extern) ----- */
+
+/* -------- Declaration of public functions (optional extern) ------------ */
+
+// Initialize the module: start the RTC from REFO and enable its interrupt. No lock is held
+void idleInit(void);
+// Set the wake-up latency the application tolerates (us)
+void idleSetLatency(uint32_t us);
+// Take a deep sleep lock: LPM3 is not used while any is held
+void idleBlockDeep(void);
+// Release a lock taken with idleBlockDeep()
+void idleAllowDeep(void);
+// Take a tickless lock: the tick keeps running (WFI only) while any is held
+void idleBlockTickless(void);
+// Release a lock taken with idleBlockTickless()
+void idleAllowTickless(void);
+// Sleep until the next interrupt (foreground, main loop). Returns the way of sleeping used
+idle_mode_t idleEnter(void);
+
+/* @} */
+
+#endif // __IDLE_H
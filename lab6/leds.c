@@ -7,6 +7,11 @@
  *
  * A source file to be to be used by the user to control the leds on a msp432p401r Launchpad board.
  * This contains the implementation for the private and public functions for the leds module.
+ * Dimmed leds are driven with binary code modulation (BCM) on Timer_A3: the frame is split in
+ * eight bit planes lasting 1, 2, 4 ... 128 time units, and in plane b every led shows bit b of
+ * its duty. That costs eight short interrupts per frame whatever the number of leds.
+ * The plane interrupt must end before the next one: when the shortest planes last less than
+ * LEDS_PWM_ISR_CYCLES they are left out, and the low bits of the duty with them.
  *
  * @{
  */
@@ -16,6 +21,9 @@
 
 /* --------------------------- Private macros ----------------------------- */
 #define NUM_LEDS (sizeof(ledsPinRef) / sizeof(output_ref_t))
+#define LEDS_PWM_PLANES 8   /* Bit planes of the 8 bits duty */
+#define LEDS_PWM_TIMER TIMER_A3
+#define LEDS_PWM_ISR_CYCLES 400 /* MCLK cycles a plane must last at least: TA3_0_IRQHandler with margin, see bench.c */
 
 /* ----------------------- Private data types ------------------------- */
 
@@ -33,6 +41,13 @@ static output_ref_t ledsPinRef[] = {
 
 /* Private variable with the status of the LEDs */
 static uint8_t ledsStatus[NUM_LEDS];
+/* Private variable with the gamma corrected duty of the LEDs (0 = off, 255 = on) */
+static volatile uint8_t ledsDuty[NUM_LEDS];
+/* Private variables of the brightness modulation */
+static uint8_t ledsPwmPlane;       /* Bit plane being shown */
+static uint16_t ledsPwmUnit;       /* Timer cycles of the shortest bit plane */
+static uint8_t ledsPwmFirst;       /* First bit plane shown, the shorter ones are too short for the ISR */
+static uint8_t ledsPwmStarted;     /* Flag (0/1), Timer_A3 running */
 
 /* ----------------- Definition of public variables --------------------- */
 
@@ -40,6 +55,10 @@ static uint8_t ledsStatus[NUM_LEDS];
 static void _ledEvenInit(DIO_PORT_Even_Interruptable_Type *port, uint16_t pin);
 static void _ledOddInit(DIO_PORT_Odd_Interruptable_Type *port, uint16_t pin);
 static void _ledInit(const output_ref_t *ref);
+static void _ledWrite(const output_ref_t *ref, uint8_t on);
+static void _ledsPwmStart(void);
+static uint8_t _ledDiv255(uint16_t x);
+void TA3_0_IRQHandler(void);
 
 /* --------- Implementation of private functions (with static) ------------ */
 static void _ledEvenInit(DIO_PORT_Even_Interruptable_Type *port, uint16_t pin)
@@ -70,6 +89,78 @@ static void _ledInit(const output_ref_t *ref)
     }
 }
 
+static void _ledWrite(const output_ref_t *ref, uint8_t on)
+{
+    if (ref->port_is_odd)
+    {
+        if (on)
+            ref->odd->OUT |= ref->mask;
+        else
+            ref->odd->OUT &= ~(ref->mask);
+    }
+    else
+    {
+        if (on)
+            ref->even->OUT |= ref->mask;
+        else
+            ref->even->OUT &= ~(ref->mask);
+    }
+}
+
+static void _ledsPwmStart(void)
+{
+    uint32_t unit, unit_min;
+    uint16_t div = 0;
+    /* Whole frame is 255 units: 1 + 2 + 4 + ... + 128 */
+    unit = CS_getSMCLK() / (LEDS_PWM_FRAME_HZ * 255);
+    /* The longest plane (128 units) must fit the 16 bits counter */
+    while ((unit << (LEDS_PWM_PLANES - 1)) > 0xFFFF && div < 3)
+    {
+        unit >>= 1;
+        div++;
+    }
+    /* Shortest plane the ISR can serve, in timer cycles */
+    unit_min = (uint32_t)(((uint64_t)LEDS_PWM_ISR_CYCLES * (CS_getSMCLK() >> div)) / CS_getMCLK()) + 1;
+    ledsPwmFirst = 0;
+    while (((unit << ledsPwmFirst) < unit_min) && (ledsPwmFirst < LEDS_PWM_PLANES - 1))
+    {
+        ledsPwmFirst++;
+    }
+    ledsPwmUnit = (uint16_t)unit;
+    ledsPwmPlane = LEDS_PWM_PLANES - 1;
+    LEDS_PWM_TIMER->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__STOP | TIMER_A_CTL_CLR
+                        | (div << TIMER_A_CTL_ID_OFS);
+    LEDS_PWM_TIMER->CCR[0] = ledsPwmUnit - 1;
+    LEDS_PWM_TIMER->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    Interrupt_enableInterrupt(INT_TA3_0);
+    LEDS_PWM_TIMER->CTL |= TIMER_A_CTL_MC__UP;
+    ledsPwmStarted = 1;
+}
+
+/* x / 255 without a division, exact for x in [0, 255 * 255] */
+static uint8_t _ledDiv255(uint16_t x)
+{
+    return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
+
+void TA3_0_IRQHandler(void)
+{
+    uint8_t i, bit;
+    LEDS_PWM_TIMER->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+    ledsPwmPlane++;
+    if (ledsPwmPlane >= LEDS_PWM_PLANES)
+    {
+        ledsPwmPlane = ledsPwmFirst;
+    }
+    /* The new period first, right after the roll over: TAR is still far below it */
+    LEDS_PWM_TIMER->CCR[0] = (ledsPwmUnit << ledsPwmPlane) - 1;
+    bit = 1 << ledsPwmPlane;
+    for (i = 0; i < NUM_LEDS; i++)
+    {
+        _ledWrite(&ledsPinRef[i], ledsDuty[i] & bit);
+    }
+}
+
 /* ---------------- Implementation of public functions ------------------ */
 void ledsInit(void)
 {
@@ -95,6 +186,7 @@ void ledOn(led_ref_t led_ref)
             ledsPinRef[led_ref].even->OUT |= ledsPinRef[led_ref].mask;
         }
         ledsStatus[led_ref] = 1;
+        ledsDuty[led_ref] = LED_LEVEL_MAX;
     }
 }
 
@@ -111,6 +203,7 @@ void ledOff(led_ref_t led_ref)
             ledsPinRef[led_ref].even->OUT &= ~(ledsPinRef[led_ref].mask);
         }
         ledsStatus[led_ref] = 0;
+        ledsDuty[led_ref] = 0;
     }
 }
 
@@ -143,4 +236,59 @@ int ledsGetNum(void)
     return NUM_LEDS;
 }
 
+void ledSetLevel(led_ref_t led_ref, uint8_t level)
+{
+    if (led_ref < NUM_LEDS)
+    {
+        ledsDuty[led_ref] = ledsGammaLut[level];
+        ledsStatus[led_ref] = (level > 0);
+        if (!ledsPwmStarted && (level > 0) && (level < LED_LEVEL_MAX))
+        {
+            _ledsPwmStart();
+        }
+        if (!ledsPwmStarted)
+        {
+            _ledWrite(&ledsPinRef[led_ref], level);
+        }
+    }
+}
+
+void ledHsvToRgb(uint16_t hue, uint8_t sat, uint8_t val, led_rgb_t *rgb)
+{
+    uint8_t sector, frac;
+    uint8_t vpqt[4];
+    const uint8_t *sel;
+
+    if (hue >= LED_HUE_MAX)
+    {
+        hue = hue % LED_HUE_MAX;
+    }
+    sector = hue / LED_HUE_SECTOR;
+    frac = hue % LED_HUE_SECTOR;
+
+    vpqt[0] = val;
+    vpqt[1] = _ledDiv255(val * (255 - sat));
+    vpqt[2] = _ledDiv255(val * (255 - _ledDiv255(sat * frac)));
+    vpqt[3] = _ledDiv255(val * (255 - _ledDiv255(sat * (255 - frac))));
+
+    sel = ledsHsvSectorLut[sector];
+    rgb->red = vpqt[sel[0]];
+    rgb->green = vpqt[sel[1]];
+    rgb->blue = vpqt[sel[2]];
+}
+
+void ledSetRgb(led_ref_t red_ref, uint8_t red, uint8_t green, uint8_t blue)
+{
+    ledSetLevel(red_ref, red);
+    ledSetLevel((led_ref_t)(red_ref + 1), green);
+    ledSetLevel((led_ref_t)(red_ref + 2), blue);
+}
+
+void ledSetHsv(led_ref_t red_ref, uint16_t hue, uint8_t sat, uint8_t val)
+{
+    led_rgb_t rgb;
+    ledHsvToRgb(hue, sat, val, &rgb);
+    ledSetRgb(red_ref, rgb.red, rgb.green, rgb.blue);
+}
+
 /* @} */
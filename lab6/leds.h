@@ -12,6 +12,10 @@
  *The public function ledToggle() can be used to toggle the state of a led, this takes a led_ref_t type as parameter.
  *The public function ledGet() returns the state of a led, either 1 (ON) or 0 (OFF), this takes a led_ref_t type as parameter.
  *The public functions ledsGetNum() return an integer value containing the amount of LEDS used in this implementation.
+ *The public function ledSetLevel() sets the brightness of a led, using the gamma lookup table to get a perceptually linear fade.
+ *The public functions ledSetRgb() and ledSetHsv() drive the three consecutive channels of a RGB led (red, green, blue).
+ *Brightness is generated with binary code modulation on Timer_A3, which is only started the first time a led is dimmed.
+ *With a slow MCLK the shortest bit planes are left out, and the finest steps of the duty with them.
  *
  * @{
  */
@@ -25,10 +29,23 @@
 #include "common.h"
 
 /* --------------------------- Public macros ----------------------------- */
+#define LED_LEVEL_MAX   255     /* Full brightness level */
+#define LED_HUE_SECTOR  256     /* Hue units per colour sector (red->yellow, yellow->green, ...) */
+#define LED_HUE_MAX     (6 * LED_HUE_SECTOR) /* Hue range is [0, LED_HUE_MAX) */
+#define LEDS_PWM_FRAME_HZ 100   /* Refresh rate of the brightness modulation */
 
 /* ----------------------- Public data types ------------------------- */
+/* Perceptual level (0..255) of each channel of a RGB led */
+typedef struct {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} led_rgb_t;
 
 /* ---- Declaration of public variables (no definition, use extern) ----- */
+/* Lookup tables generated by tools/ledlut.py into ledlut.c (placed in flash) */
+extern const uint8_t ledsGammaLut[256];
+extern const uint8_t ledsHsvSectorLut[6][3];
 
 /* Enumeration of the LEDs managed by the module */
 enum led_ref_e {
@@ -49,6 +66,10 @@ void ledOff(led_ref_t led_ref);
 void ledToggle(led_ref_t led_ref);
 uint8_t ledGet(led_ref_t led_ref);
 int ledsGetNum(void);
+void ledSetLevel(led_ref_t led_ref, uint8_t level);
+void ledHsvToRgb(uint16_t hue, uint8_t sat, uint8_t val, led_rgb_t *rgb);
+void ledSetRgb(led_ref_t red_ref, uint8_t red, uint8_t green, uint8_t blue);
+void ledSetHsv(led_ref_t red_ref, uint16_t hue, uint8_t sat, uint8_t val);
 
 /* @} */
 
@@ -6,6 +6,7 @@
  * @brief Main file of Practica 5
  *
  * Main file containing the initialization of the leds and the time module together with the callback function from the buttons module.
+ * Button edges go through the gesture module, and the main loop drains its event queue, then sleeps in idleEnter().
  *
  * @{
  */
@@ -13,6 +14,15 @@
 #include "leds.h"
 #include "buttons.h"
 #include "stime.h"
+#include "gesture.h"
+#include "bench.h"
+#include "idle.h"
+
+#ifdef MAIN_BENCH
+/* Build with MAIN_BENCH defined and read benchResult and benchButtons in the debugger */
+bench_result_t benchResult;
+bench_buttons_t benchButtons;
+#endif
 
 
 int main(void)
@@ -21,19 +31,38 @@ int main(void)
 
     ledsInit();             /* Initialize all leds and turn them off */
     stimeInit(3000000);        /* Initialize the stime module for timed delay */
+    gestureInit();          /* Empty the button event queue */
     buttonsInit();
+    stimeExecMillis(GESTURE_TICK_MS);   /* Period of the gesture timers (stimeCallback) */
 
     Interrupt_enableMaster();
 
+#ifdef MAIN_BENCH
+    benchRun(BP_LED1_RED, &benchResult);
+    benchButtonsRun(&benchButtons);
+#endif
+
+    idleInit();
+    idleBlockDeep();        /* The leds PWM runs on SMCLK: LPM0 at most */
+    idleBlockTickless();    /* LP_S1 and LP_S2 are polled from every tick: WFI only */
+
+    while (1)
+    {
+        gesture_event_t ev;
+        while (gestureGet(&ev))
+        {
+            if ((ev.type == GESTURE_PRESS) && ((ev.button == BP_S1) || (ev.button == BP_S2)))
+            {
+                ledToggle(LP_LED1);
+            }
+        }
+        /* Nothing to do until the next interrupt, the tick at the latest */
+        idleEnter();
+    }
 }
 
-void buttonCallback(int button_index)
+void stimeCallback(void)
 {
-    if(button_index == BP_S1){
-        ledToggle(LP_LED1);
-    }
-    else if(button_index == BP_S2){
-        ledToggle(LP_LED1);
-    }
+    gestureTick();
 }
 
@@ -88,6 +88,7 @@ SECTIONS
     .pinit  :   > MAIN
     .init_array   :     > MAIN
     .binit        : {}  > MAIN
+    .ledlut :   > MAIN                  /* leds module lookup tables (tools/ledlut.py) */
 
     /* The following sections show the usage of the INFO flash memory        */
     /* INFO flash memory is intended to be used for the following            */
@@ -106,6 +107,7 @@ SECTIONS
     .pinit  :   > MAIN, crc_table(crc_table_for_pinit)
     .init_array   :     > MAIN, crc_table(crc_table_for_init_array)
     .binit        : {}  > MAIN, crc_table(crc_table_for_binit)
+    .ledlut :   > MAIN, crc_table(crc_table_for_ledlut)
 
     /* The following sections show the usage of the INFO flash memory        */
     /* INFO flash memory is intended to be used for the following            */
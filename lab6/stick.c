@@ -77,6 +77,10 @@ uint32_t stickGetCount(void){
     return (SysTick->VAL & SysTick_VAL_CURRENT_Msk);
 }
 
+void stickResetCount(void){
+    SysTick->VAL = 0;   // Any write clears the counter, reloaded on the next clock
+}
+
 void stickClearIntFlag(void){
     SysTick->CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
 }
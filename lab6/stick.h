@@ -48,6 +48,8 @@ void stickSetPeriod(uint32_t p);
 uint32_t stickGetPeriod(void);
 // Current value of the timer. Returns c, being c the registry value STCVR
 uint32_t stickGetCount(void);
+// Restart the current period from its beginning (clears the flag COUNTFLAG as a side effect)
+void stickResetCount(void);
 // Clear the flag COUNTFLAG timer interrupt
 void stickClearIntFlag(void);
 // Determines if the timer interrupt flag is set by parsing the bit COUNTFLAG.Returns 1 if the flag is activated, 0 otherwise.
@@ -13,6 +13,7 @@
 
 /* ---------------- #includes needed for this file ----------------- */
 #include "stime.h"
+#include "critical.h"
 
 /* --------------------------- Private macros ----------------------------- */
 
@@ -40,6 +41,7 @@ uint32_t timed_exec_count;
 // Definition of the callback function of the module stick in this module
 void stickCallback(void){
     ms++;
+    stimeTickCallback();
 
     if(timed_exec_period == 0){
         timed_exec_count = 0;
@@ -53,6 +55,8 @@ void stickCallback(void){
 }
 
 void stimeCallback(void) __attribute__((weak));
+void stimeTickCallback(void) __attribute__((weak));
+void stimeTickCallback(void){}
 
 /* ---------------- Implementation of public functions ------------------ */
 
@@ -69,9 +73,9 @@ void stimeInit(uint32_t clkHz){
 
 uint64_t stimeElapsedMillis(void){
     uint64_t millis;
-    stickDisableInt();
+    critical_t s = criticalEnter();
     millis = ms;
-    stickEnableInt();
+    criticalExit(s);
     return millis;
 }
 
@@ -83,10 +87,31 @@ void stimeWaitMillis(uint32_t millis){
 }
 
 void stimeExecMillis (uint32_t millis){
-    stickDisableInt();
+    critical_t s = criticalEnter();
     timed_exec_period = millis;
     timed_exec_count = 0;
-    stickEnableInt();
+    criticalExit(s);
+}
+
+uint32_t stimeNextDeadline(void){
+    uint32_t left;
+    critical_t s = criticalEnter();
+    left = (timed_exec_period == 0) ? UINT32_MAX : timed_exec_period - timed_exec_count;
+    criticalExit(s);
+    return left;
+}
+
+void stimeAdvance(uint32_t millis){
+    critical_t s = criticalEnter();
+    ms += millis;
+    if(timed_exec_period != 0){
+        // A timed execution missed while sleeping runs on the next tick, from the interrupt as usual
+        timed_exec_count += millis;
+        if(timed_exec_count >= timed_exec_period){
+            timed_exec_count = timed_exec_period - 1;
+        }
+    }
+    criticalExit(s);
 }
 
 
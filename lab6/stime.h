@@ -39,8 +39,14 @@ uint64_t stimeElapsedMillis(void);
 void stimeWaitMillis(uint32_t millis);
 // Sets the execution period of the function stimeCallback ()
 void stimeExecMillis (uint32_t millis);
+// Returns the milliseconds left before the next stimeCallback (), UINT32_MAX if none is programmed
+uint32_t stimeNextDeadline(void);
+// Accounts milliseconds elapsed while the tick was stopped (tickless idle)
+void stimeAdvance(uint32_t millis);
 // Callback function called from the stickCallback
 extern void stimeCallback(void);
+// Callback function called from the stickCallback on every tick (each millisecond)
+extern void stimeTickCallback(void);
 
 
 /* @} */
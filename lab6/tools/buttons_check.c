@@ -0,0 +1,295 @@
+/**
+ * @file buttons_check.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Host check of the port interrupt dispatch of the buttons module.
+ *
+ * buttons.c is compiled into this program, on the port model of tools/host (PxIV reads
+ * clear the flag they report). Every interrupt input is pressed alone, then all the
+ * inputs of a port at once with an enabled flag on an unused pin, then released, and:
+ * - one handler call drains the port: PxIV is read once per pending pin plus the final 0
+ * - every pending input is disarmed and its filter woken up, the others are not touched
+ * - the debounced event reaches the handler of the right input, and the pin is re-armed
+ *   on the opposite edge once settled
+ * Exit status 0 when every check passes. Build and run from lab6, with the board inputs
+ * or with 48 inputs on interrupts:
+ * gcc -std=gnu11 -Wall -Itools/host -I. tools/buttons_check.c tools/host/host.c -o tools/buttons_check.out
+ * gcc -std=gnu11 -Wall -Itools/host -I. -DBUTTONS_BENCH_INPUTS=48 -DBUTTONS_BENCH_INTERRUPT=1
+ *     tools/buttons_check.c tools/host/host.c -o tools/buttons_check.out
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdio.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+static uint16_t _checkReadIV(volatile const uint16_t *iv_reg);
+#define BUTTONS_READ_IV(reg) _checkReadIV(reg)
+#include "../buttons.c"
+
+/* --------------------------- Private macros ----------------------------- */
+#define CHECK_SETTLE_TICKS 64   /* More than any settle time */
+#define CHECK_PORTS NUM_INT_PORTS
+
+/* ----------- Definition of private variables (with static) -------------- */
+static uint32_t checkIVReads;
+static uint32_t checkErrors;
+static uint32_t checkDispatches;
+static int checkEvents[NUM_BUTTONS][2];     /* Events received per input, press and release */
+static void (* const checkHandlers[CHECK_PORTS])(void) = {
+    PORT1_IRQHandler, PORT2_IRQHandler, PORT3_IRQHandler,
+    PORT4_IRQHandler, PORT5_IRQHandler, PORT6_IRQHandler,
+};
+
+/* --------- Implementation of private functions (with static) ------------ */
+static uint16_t _checkReadIV(volatile const uint16_t *iv_reg)
+{
+    checkIVReads++;
+    return hostPortIV(iv_reg);
+}
+
+static void _checkFail(const char *what, int i)
+{
+    checkErrors++;
+    if (checkErrors <= 20)
+    {
+        printf("input %d: %s\n", i, what);
+    }
+}
+
+static void _checkHandler(int button_index, button_event_t event, void *ctx)
+{
+    (void)ctx;
+    checkEvents[button_index][event]++;
+}
+
+static uint8_t _checkPort(int i)
+{
+    return buttonsPinRef[i].int_num - INT_PORT1 + 1;
+}
+
+static uint8_t _checkIE(int i)
+{
+    const input_pinref_t *ref = &buttonsPinRef[i];
+    return (ref->port_is_odd ? ref->odd->IE : ref->even->IE) & ref->mask;
+}
+
+static uint8_t _checkIES(int i)
+{
+    const input_pinref_t *ref = &buttonsPinRef[i];
+    return (ref->port_is_odd ? ref->odd->IES : ref->even->IES) & ref->mask;
+}
+
+/* Enable the unused pins of the mask on port and raise their flags (on = 1), or disable them */
+static void _checkSpare(uint8_t port, uint8_t mask, uint8_t on)
+{
+    /* Ports go in pairs 0x20 apart, the odd one first */
+    DIO_PORT_Odd_Interruptable_Type *odd = (DIO_PORT_Odd_Interruptable_Type *)(DIO_BASE + ((port - 1) >> 1) * 0x20);
+    DIO_PORT_Even_Interruptable_Type *even = (DIO_PORT_Even_Interruptable_Type *)odd;
+    volatile uint8_t *ie = (port & 1) ? &odd->IE : &even->IE;
+    volatile uint8_t *ifg = (port & 1) ? &odd->IFG : &even->IFG;
+    if (on)
+    {
+        *ie |= mask;
+        *ifg |= mask;
+    }
+    else
+    {
+        *ie &= ~mask;
+    }
+}
+
+/* Take the port interrupt if it is pending, as the NVIC would. Returns the PxIV reads */
+static uint32_t _checkIRQ(uint8_t port)
+{
+    uint32_t reads = checkIVReads;
+    if (hostPortPending(port))
+    {
+        checkDispatches++;
+        checkHandlers[port - 1]();
+        if (hostPortPending(port))
+        {
+            _checkFail("port left pending by its handler", -1);
+        }
+    }
+    return checkIVReads - reads;
+}
+
+static void _checkTicks(int n)
+{
+    while (n-- > 0)
+    {
+        stimeTickCallback();
+    }
+}
+
+/* Press (level 0) or release (level 1) the inputs of the mask (bit i = input i) at once,
+   with an enabled flag on the unused pin spare of their port if there is one */
+static void _checkEdge(const uint8_t *sel, uint8_t level, uint8_t spare)
+{
+    int i, pending = 0;
+    uint8_t port = 0, spare_mask = 0;
+    uint32_t reads;
+
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (sel[i])
+        {
+            port = _checkPort(i);
+            hostPinWrite(port, buttonsPinRef[i].mask, level);
+            pending++;
+            if (buttonsDebounce[i].active)
+            {
+                _checkFail("filter already awake before the edge", i);
+            }
+        }
+    }
+    if (spare != 0xFF)
+    {
+        spare_mask = 1 << spare;
+        _checkSpare(port, spare_mask, 1);
+        pending++;
+    }
+
+    reads = _checkIRQ(port);
+    if (reads != (uint32_t)pending + 1)
+    {
+        _checkFail("PxIV not read once per pending pin plus the final 0", -1);
+    }
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (!buttonsPinRef[i].use_interrupt)
+        {
+            continue;
+        }
+        if (sel[i] && (!buttonsDebounce[i].active || _checkIE(i)))
+        {
+            _checkFail("pending input not disarmed and woken up", i);
+        }
+        if (!sel[i] && (buttonsDebounce[i].active || !_checkIE(i)))
+        {
+            _checkFail("input of another pin touched by the dispatch", i);
+        }
+    }
+    if (spare_mask != 0)
+    {
+        /* Unused pin: its flag was drained, the pin is left to whoever enabled it */
+        _checkSpare(port, spare_mask, 0);
+    }
+
+    _checkTicks(CHECK_SETTLE_TICKS);
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (!buttonsPinRef[i].use_interrupt)
+        {
+            continue;
+        }
+        if (buttonsDebounce[i].active || !_checkIE(i))
+        {
+            _checkFail("input not re-armed once settled", i);
+        }
+        /* Released: wait for the falling edge (PxIES = 1), pressed: for the rising one */
+        if ((_checkIES(i) != 0) != (buttonsDebounce[i].state == 0))
+        {
+            _checkFail("re-armed on the wrong edge", i);
+        }
+    }
+}
+
+/* Events of input i since the last call, and of nobody else */
+static void _checkEvents(const uint8_t *sel, button_event_t event)
+{
+    int i;
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (checkEvents[i][event] != (sel[i] ? 1 : 0) || checkEvents[i][!event] != 0)
+        {
+            _checkFail(event == BUTTON_EVENT_PRESS ? "press not delivered once to its input"
+                                                   : "release not delivered once to its input", i);
+        }
+        checkEvents[i][0] = 0;
+        checkEvents[i][1] = 0;
+    }
+}
+
+/* ---------------- Implementation of public functions ------------------ */
+int main(void)
+{
+    uint8_t sel[NUM_BUTTONS];
+    uint8_t port, pin, used;
+    int i, j, inputs = 0;
+
+    /* Every pin idles high: released */
+    for (port = 1; port <= CHECK_PORTS; port++)
+    {
+        hostPinWrite(port, 0xFF, 1);
+    }
+    buttonsInit();
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        buttonOnEvent((button_ref_t)i, BUTTON_EVENT_MASK(BUTTON_EVENT_PRESS) | BUTTON_EVENT_MASK(BUTTON_EVENT_RELEASE),
+                      _checkHandler, 0);
+        if (buttonsPinRef[i].use_interrupt)
+        {
+            inputs++;
+        }
+    }
+    _checkTicks(CHECK_SETTLE_TICKS);
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (buttonsPinRef[i].use_interrupt && (buttonsDebounce[i].active || !_checkIE(i)))
+        {
+            _checkFail("input not armed after the start", i);
+        }
+    }
+
+    /* One input at a time */
+    for (i = 0; i < NUM_BUTTONS; i++)
+    {
+        if (!buttonsPinRef[i].use_interrupt)
+        {
+            continue;
+        }
+        for (j = 0; j < NUM_BUTTONS; j++)
+        {
+            sel[j] = (j == i);
+        }
+        _checkEdge(sel, 0, 0xFF);
+        _checkEvents(sel, BUTTON_EVENT_PRESS);
+        _checkEdge(sel, 1, 0xFF);
+        _checkEvents(sel, BUTTON_EVENT_RELEASE);
+    }
+
+    /* Every input of a port at once, plus an unused pin if there is one */
+    for (port = 1; port <= CHECK_PORTS; port++)
+    {
+        used = 0;
+        for (j = 0; j < NUM_BUTTONS; j++)
+        {
+            sel[j] = buttonsPinRef[j].use_interrupt && (_checkPort(j) == port);
+            if (sel[j])
+            {
+                used |= buttonsPinRef[j].mask;
+            }
+        }
+        if (used == 0)
+        {
+            continue;
+        }
+        for (pin = 0; (pin < PINS_PER_PORT) && (used & (1 << pin)); pin++)
+        {
+        }
+        _checkEdge(sel, 0, pin < PINS_PER_PORT ? pin : 0xFF);
+        _checkEvents(sel, BUTTON_EVENT_PRESS);
+        _checkEdge(sel, 1, 0xFF);
+        _checkEvents(sel, BUTTON_EVENT_RELEASE);
+    }
+
+    printf("%d inputs, %d on interrupts, %u dispatches, %u PxIV reads, %u errors\n", (int)NUM_BUTTONS, inputs,
+           (unsigned)checkDispatches, (unsigned)checkIVReads, (unsigned)checkErrors);
+    return checkErrors != 0;
+}
+
+/* @} */
@@ -0,0 +1,234 @@
+/**
+ * @file buttons_trace.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Host replay of a bounce trace through the debounce filter of the buttons module.
+ *
+ * buttons.c is compiled into this program, on the port model of tools/host. The trace
+ * (time in microseconds and pin level at each change, see bounce_trace.txt) drives LP_S1,
+ * which is polled, and BP_S1, which wakes its filter up from the port interrupt, while the
+ * 1 ms tick runs. The debounced events of both inputs must match, to the tick, the
+ * reference: a press (release) at the first tick where the last BUTTONS_PRESS_SETTLE_MS
+ * (BUTTONS_RELEASE_SETTLE_MS) samples all read pressed (released) and the state was the
+ * other one. With BUTTONS_DEBOUNCE_VERTICAL both inputs are sampled every
+ * buttonsSamplePeriod ticks, and the reference toggles after four samples at the other
+ * level. The count of presses is also checked against the "# presses" line of the
+ * trace, if any. Exit status 0 when every check passes.
+ * Build and run from lab6 (add -DBUTTONS_DEBOUNCE_VERTICAL=1 for the vertical counters):
+ * gcc -std=gnu11 -Wall -Itools/host -I. tools/buttons_trace.c tools/host/host.c -o tools/buttons_trace.out
+ * tools/buttons_trace.out [ trace ]
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define BUTTONS_READ_IV(reg) hostPortIV(reg)
+#include "../buttons.c"
+
+/* --------------------------- Private macros ----------------------------- */
+#define TRACE_DEFAULT "tools/bounce_trace.txt"
+#define TRACE_MAX_CHANGES 4096
+#define TRACE_MAX_EVENTS 256
+#define TRACE_TAIL_MS 100       /* Ticks played after the last change */
+#define TRACE_INPUTS 2          /* LP_S1 and BP_S1 */
+
+/* ----------------------- Private data types ------------------------- */
+typedef struct {
+    uint32_t time_us;
+    uint8_t level;
+} trace_change_t;
+typedef struct {
+    uint32_t tick;
+    button_event_t event;
+} trace_event_t;
+typedef struct {
+    trace_event_t ev[TRACE_MAX_EVENTS];
+    int n;
+} trace_log_t;
+
+/* ----------- Definition of private variables (with static) -------------- */
+static trace_change_t traceChanges[TRACE_MAX_CHANGES];
+static int traceNumChanges;
+static int tracePresses = -1;           /* From the "# presses" line, -1 if none */
+static uint32_t traceTick;              /* Ticks played */
+static uint32_t traceIRQs;              /* PORT5_IRQHandler() calls */
+static trace_log_t traceLog[TRACE_INPUTS];
+static trace_log_t traceRef;
+static const button_ref_t traceInputs[TRACE_INPUTS] = {LP_S1, BP_S1};
+
+/* --------- Implementation of private functions (with static) ------------ */
+static int _traceLoad(const char *name)
+{
+    char line[128];
+    unsigned long t;
+    int level, presses;
+    FILE *f = fopen(name, "r");
+    if (f == 0)
+    {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != 0)
+    {
+        if (sscanf(line, "# presses %d", &presses) == 1)
+        {
+            tracePresses = presses;
+        }
+        else if ((line[0] != '#') && (sscanf(line, "%lu %d", &t, &level) == 2)
+                 && (traceNumChanges < TRACE_MAX_CHANGES))
+        {
+            traceChanges[traceNumChanges].time_us = t;
+            traceChanges[traceNumChanges].level = (level != 0);
+            traceNumChanges++;
+        }
+    }
+    fclose(f);
+    return traceNumChanges > 0 ? 0 : -1;
+}
+
+static void _traceLogEvent(trace_log_t *log, button_event_t event)
+{
+    if (log->n < TRACE_MAX_EVENTS)
+    {
+        log->ev[log->n].tick = traceTick;
+        log->ev[log->n].event = event;
+        log->n++;
+    }
+}
+
+static void _traceHandler(int button_index, button_event_t event, void *ctx)
+{
+    (void)button_index;
+    _traceLogEvent((trace_log_t *)ctx, event);
+}
+
+/* Level of the pin on both inputs, and the port interrupt if BP_S1 raised it */
+static void _tracePin(uint8_t level)
+{
+    hostPinWrite(1, buttonsPinRef[LP_S1].mask, level);
+    hostPinWrite(5, buttonsPinRef[BP_S1].mask, level);
+    if (hostPortPending(5))
+    {
+        traceIRQs++;
+        PORT5_IRQHandler();
+    }
+}
+
+/* Reference filter: the window of the last settle samples, kept as a history of levels */
+static void _traceReference(uint8_t *history, uint8_t level, uint8_t *state)
+{
+    int k, settle;
+    uint8_t pressed = !level;
+#if BUTTONS_DEBOUNCE_VERTICAL
+    if (traceTick % buttonsSamplePeriod != 0)
+    {
+        return;
+    }
+    settle = 4;
+#else
+    settle = pressed ? BUTTONS_PRESS_SETTLE_MS : BUTTONS_RELEASE_SETTLE_MS;
+#endif
+    memmove(history + 1, history, 255);
+    history[0] = pressed;
+    if (pressed == *state)
+    {
+        return;
+    }
+    for (k = 0; k < settle; k++)
+    {
+        if (history[k] != pressed)
+        {
+            return;
+        }
+    }
+    *state = pressed;
+    _traceLogEvent(&traceRef, pressed ? BUTTON_EVENT_PRESS : BUTTON_EVENT_RELEASE);
+}
+
+static int _traceCompare(const char *name, const trace_log_t *log)
+{
+    int k, errors = 0;
+    if (log->n != traceRef.n)
+    {
+        printf("%s: %d events, the reference has %d\n", name, log->n, traceRef.n);
+        errors++;
+    }
+    for (k = 0; (k < log->n) && (k < traceRef.n); k++)
+    {
+        if ((log->ev[k].tick != traceRef.ev[k].tick) || (log->ev[k].event != traceRef.ev[k].event))
+        {
+            printf("%s: event %d is %s at %u ms, the reference %s at %u ms\n", name, k,
+                   log->ev[k].event == BUTTON_EVENT_PRESS ? "press" : "release", (unsigned)log->ev[k].tick,
+                   traceRef.ev[k].event == BUTTON_EVENT_PRESS ? "press" : "release",
+                   (unsigned)traceRef.ev[k].tick);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+/* ---------------- Implementation of public functions ------------------ */
+int main(int argc, char *argv[])
+{
+    static uint8_t history[256];
+    const char *name = (argc > 1) ? argv[1] : TRACE_DEFAULT;
+    uint8_t level, ref_state;
+    uint32_t end;
+    int c = 0, i, presses = 0, errors = 0;
+
+    if (_traceLoad(name) != 0)
+    {
+        printf("%s: no trace\n", name);
+        return 2;
+    }
+
+    /* Start from the first level of the trace, settled */
+    level = traceChanges[0].level;
+    hostPinWrite(1, 0xFF, 1);
+    hostPinWrite(5, 0xFF, 1);
+    hostPinWrite(1, buttonsPinRef[LP_S1].mask, level);
+    hostPinWrite(5, buttonsPinRef[BP_S1].mask, level);
+    buttonsInit();
+    for (i = 0; i < TRACE_INPUTS; i++)
+    {
+        buttonOnEvent(traceInputs[i], BUTTON_EVENT_MASK(BUTTON_EVENT_PRESS) | BUTTON_EVENT_MASK(BUTTON_EVENT_RELEASE),
+                      _traceHandler, &traceLog[i]);
+    }
+    ref_state = !level;
+    memset(history, ref_state, sizeof(history));
+
+    end = traceChanges[traceNumChanges - 1].time_us / 1000 + TRACE_TAIL_MS;
+    for (traceTick = 1; traceTick <= end; traceTick++)
+    {
+        /* The changes before the tick, then the sample */
+        while ((c < traceNumChanges) && (traceChanges[c].time_us < traceTick * 1000))
+        {
+            level = traceChanges[c++].level;
+            _tracePin(level);
+        }
+        stimeTickCallback();
+        _traceReference(history, level, &ref_state);
+    }
+
+    errors += _traceCompare("LP_S1 (polled)", &traceLog[0]);
+    errors += _traceCompare("BP_S1 (interrupt)", &traceLog[1]);
+    for (i = 0; i < traceRef.n; i++)
+    {
+        presses += (traceRef.ev[i].event == BUTTON_EVENT_PRESS);
+    }
+    if ((tracePresses >= 0) && (presses != tracePresses))
+    {
+        printf("%d presses, the trace says %d\n", presses, tracePresses);
+        errors++;
+    }
+    printf("%s: %d changes, %u ms, %d events (%d presses), %u port interrupts, %d errors\n", name,
+           traceNumChanges, (unsigned)end, traceRef.n, presses, (unsigned)traceIRQs, errors);
+    return errors != 0;
+}
+
+/* @} */
@@ -0,0 +1,94 @@
+/**
+ * @file host.c
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Peripherals and driverlib of the host build of the programs in tools/.
+ *
+ * Link with every host program that compiles buttons.c. The registers are zero at start.
+ * The port model keeps what the buttons module relies on: an edge selected by PxIES sets
+ * PxIFG whatever PxIE, and a PxIV read reports the lowest pending enabled pin and clears
+ * its flag, so a handler that loops on PxIV drains the port.
+ *
+ * @{
+ */
+
+/* ---------------- #includes needed for this file ----------------- */
+#include <stddef.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* --------------------------- Private macros ----------------------------- */
+/* Offsets in hostDio: the pair P1/P2 at 0x00, P3/P4 at 0x20..., even ports one byte up */
+#define HOST_PAIR(port) ((((port) - 1) >> 1) * 0x20)
+#define HOST_EVEN(port) ((((port) - 1) & 1) == 1)
+#define HOST_REG(port, odd_type, member) \
+    (&hostDio[HOST_PAIR(port) + (HOST_EVEN(port) ? offsetof(DIO_PORT_Even_Interruptable_Type, member) \
+                                                 : offsetof(odd_type, member))])
+#define HOST_IN(port)  (*HOST_REG(port, DIO_PORT_Odd_Interruptable_Type, IN))
+#define HOST_IES(port) (*HOST_REG(port, DIO_PORT_Odd_Interruptable_Type, IES))
+#define HOST_IE(port)  (*HOST_REG(port, DIO_PORT_Odd_Interruptable_Type, IE))
+#define HOST_IFG(port) (*HOST_REG(port, DIO_PORT_Odd_Interruptable_Type, IFG))
+#define HOST_PORTS 8
+
+/* ----------------- Definition of public variables --------------------- */
+uint8_t hostDio[0x80];
+SysTick_Type hostSysTick;
+DWT_Type hostDwt;
+CoreDebug_Type hostCoreDebug;
+uint8_t hostIntEnabled[64];
+
+/* ---------------- Implementation of public functions ------------------ */
+void Interrupt_enableInterrupt(uint32_t interruptNumber)
+{
+    hostIntEnabled[interruptNumber & 63] = 1;
+}
+
+void Interrupt_disableInterrupt(uint32_t interruptNumber)
+{
+    hostIntEnabled[interruptNumber & 63] = 0;
+}
+
+void hostPinWrite(uint8_t port, uint8_t mask, uint8_t level)
+{
+    uint8_t old = HOST_IN(port);
+    uint8_t now = level ? (old | mask) : (old & ~mask);
+    uint8_t rising = ~old & now;
+    uint8_t falling = old & ~now;
+
+    HOST_IN(port) = now;
+    /* PxIES = 1 selects the falling edge */
+    HOST_IFG(port) |= (falling & HOST_IES(port)) | (rising & ~HOST_IES(port));
+}
+
+uint16_t hostPortIV(volatile const uint16_t *iv_reg)
+{
+    uint8_t port, pin, pending;
+    for (port = 1; port <= HOST_PORTS; port++)
+    {
+        if ((const volatile uint8_t *)iv_reg == HOST_REG(port, DIO_PORT_Odd_Interruptable_Type, IV))
+        {
+            break;
+        }
+    }
+    if (port > HOST_PORTS)
+    {
+        return 0;
+    }
+    pending = HOST_IFG(port) & HOST_IE(port);
+    for (pin = 0; pin < 8; pin++)
+    {
+        if (pending & (1 << pin))
+        {
+            HOST_IFG(port) &= ~(1 << pin);
+            return 2 * (pin + 1);
+        }
+    }
+    return 0;
+}
+
+uint8_t hostPortPending(uint8_t port)
+{
+    return HOST_IFG(port) & HOST_IE(port);
+}
+
+/* @} */
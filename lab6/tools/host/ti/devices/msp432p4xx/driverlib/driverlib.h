@@ -0,0 +1,33 @@
+/**
+ * @file driverlib.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Host stand-in for the TI driverlib, for the programs in tools/.
+ *
+ * The functions are in host.c: interrupt enables are recorded in hostIntEnabled.
+ *
+ * @{
+ */
+#ifndef HOST_DRIVERLIB_H
+#define HOST_DRIVERLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../inc/msp.h"
+
+#define INT_PORT1 (51)
+#define INT_PORT2 (52)
+#define INT_PORT3 (53)
+#define INT_PORT4 (54)
+#define INT_PORT5 (55)
+#define INT_PORT6 (56)
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber);
+void Interrupt_disableInterrupt(uint32_t interruptNumber);
+
+extern uint8_t hostIntEnabled[64];  /* Interrupt_enableInterrupt() state per number */
+
+/* @} */
+
+#endif // HOST_DRIVERLIB_H
@@ -0,0 +1,90 @@
+/**
+ * @file msp.h
+ * @author Alexander Ghyoot, Michal Kos
+ * @date October 2026
+ *
+ * @brief Host stand-in for the TI device header, for the programs in tools/.
+ *
+ * Only what buttons.c and its headers use. The ports are plain memory (host.c) with the
+ * real P1 to P8 layout, so a host program drives PxIN and reads PxIE and PxIES back;
+ * hostPinWrite() and hostPortIV() play the edge detection and the PxIV read.
+ * The core intrinsics do nothing.
+ *
+ * @{
+ */
+#ifndef HOST_MSP_H
+#define HOST_MSP_H
+
+#include <stdint.h>
+
+#define __I volatile const
+#define __O volatile
+#define __IO volatile
+
+typedef struct {
+    __I uint8_t IN; uint8_t r0; __IO uint8_t OUT; uint8_t r1; __IO uint8_t DIR; uint8_t r2;
+    __IO uint8_t REN; uint8_t r3; __IO uint8_t DS; uint8_t r4; __IO uint8_t SEL0; uint8_t r5;
+    __IO uint8_t SEL1; uint8_t r6; __I uint16_t IV; uint8_t r7[6]; __IO uint8_t SELC; uint8_t r8;
+    __IO uint8_t IES; uint8_t r9; __IO uint8_t IE; uint8_t r10; __IO uint8_t IFG; uint8_t r11;
+} DIO_PORT_Odd_Interruptable_Type;
+typedef struct {
+    uint8_t r0; __I uint8_t IN; uint8_t r1; __IO uint8_t OUT; uint8_t r2; __IO uint8_t DIR;
+    uint8_t r3; __IO uint8_t REN; uint8_t r4; __IO uint8_t DS; uint8_t r5; __IO uint8_t SEL0;
+    uint8_t r6; __IO uint8_t SEL1; uint8_t r7[9]; __IO uint8_t SELC; uint8_t r8; __IO uint8_t IES;
+    uint8_t r9; __IO uint8_t IE; uint8_t r10; __IO uint8_t IFG; __I uint16_t IV;
+} DIO_PORT_Even_Interruptable_Type;
+
+extern uint8_t hostDio[0x80];   /* P1 to P8 */
+#define DIO_BASE ((uintptr_t)hostDio)
+#define P1 ((DIO_PORT_Odd_Interruptable_Type *)(DIO_BASE + 0x00))
+#define P2 ((DIO_PORT_Even_Interruptable_Type *)(DIO_BASE + 0x00))
+#define P3 ((DIO_PORT_Odd_Interruptable_Type *)(DIO_BASE + 0x20))
+#define P4 ((DIO_PORT_Even_Interruptable_Type *)(DIO_BASE + 0x20))
+#define P5 ((DIO_PORT_Odd_Interruptable_Type *)(DIO_BASE + 0x40))
+#define P6 ((DIO_PORT_Even_Interruptable_Type *)(DIO_BASE + 0x40))
+#define P7 ((DIO_PORT_Odd_Interruptable_Type *)(DIO_BASE + 0x60))
+#define P8 ((DIO_PORT_Even_Interruptable_Type *)(DIO_BASE + 0x60))
+
+#define BIT0 (0x01)
+#define BIT1 (0x02)
+#define BIT2 (0x04)
+#define BIT3 (0x08)
+#define BIT4 (0x10)
+#define BIT5 (0x20)
+#define BIT6 (0x40)
+#define BIT7 (0x80)
+#define BIT(x) (1u << (x))
+
+typedef struct { __IO uint32_t CTRL, LOAD, VAL; __I uint32_t CALIB; } SysTick_Type;
+extern SysTick_Type hostSysTick;
+#define SysTick (&hostSysTick)
+
+typedef struct { __IO uint32_t CTRL; __IO uint32_t CYCCNT; } DWT_Type;
+extern DWT_Type hostDwt;
+#define DWT (&hostDwt)
+#define DWT_CTRL_CYCCNTENA_Msk 1ul
+
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+extern CoreDebug_Type hostCoreDebug;
+#define CoreDebug (&hostCoreDebug)
+#define CoreDebug_DEMCR_TRCENA_Msk (1ul << 24)
+
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t x) { (void)x; }
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+static inline void __WFI(void) {}
+static inline void __DSB(void) {}
+static inline void __DMB(void) {}
+
+/* Level of pin mask of port (1 to 8) set to 0 or 1. An edge that PxIES selects sets PxIFG */
+void hostPinWrite(uint8_t port, uint8_t mask, uint8_t level);
+/* PxIV read: 2 * (pin + 1) of the lowest pin with PxIFG and PxIE set, whose PxIFG it clears,
+   or 0 */
+uint16_t hostPortIV(volatile const uint16_t *iv_reg);
+/* PxIFG & PxIE of port (1 to 8): the port interrupt would be taken */
+uint8_t hostPortPending(uint8_t port);
+
+/* @} */
+
+#endif // HOST_MSP_H
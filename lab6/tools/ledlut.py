@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+@file    ledlut.py
+@author  Alexander Ghyoot, Michal Kos
+@date    October 2026
+
+@brief   Host script that generates the constant lookup tables of the leds module.
+
+Run as a pre-build step of the CCS project (see .cproject) or by hand:
+
+    python3 tools/ledlut.py ledlut.c [gamma]
+
+The generated file contains:
+ - ledsGammaLut: perceptual level (0..255) to gamma corrected duty (0..255)
+ - ledsHsvSectorLut: for each of the six hue sectors, which of the values
+   (v, p, q, t) drives the red, green and blue channels
+
+Both tables are placed in the ".ledlut" section, which msp432p401r.cmd maps
+to MAIN flash.
+"""
+import sys
+
+DEFAULT_GAMMA = 2.2
+
+# HSV sector table: index into {v, p, q, t} for (red, green, blue)
+HSV_V, HSV_P, HSV_Q, HSV_T = range(4)
+HSV_SECTORS = [
+    (HSV_V, HSV_T, HSV_P),  # red -> yellow
+    (HSV_Q, HSV_V, HSV_P),  # yellow -> green
+    (HSV_P, HSV_V, HSV_T),  # green -> cyan
+    (HSV_P, HSV_Q, HSV_V),  # cyan -> blue
+    (HSV_T, HSV_P, HSV_V),  # blue -> magenta
+    (HSV_V, HSV_P, HSV_Q),  # magenta -> red
+]
+
+
+def gamma_table(gamma):
+    table = []
+    for level in range(256):
+        duty = int(round(255.0 * ((level / 255.0) ** gamma)))
+        # Any non-zero level must light the LED
+        if level > 0 and duty == 0:
+            duty = 1
+        table.append(duty)
+    return table
+
+
+def emit(path, gamma):
+    lines = []
+    lines.append("/**")
+    lines.append(" * @file ledlut.c")
+    lines.append(" * @author Alexander Ghyoot, Michal Kos")
+    lines.append(" *")
+    lines.append(" * @brief Lookup tables of the leds module.")
+    lines.append(" *")
+    lines.append(" * GENERATED FILE, DO NOT EDIT. Produced by tools/ledlut.py (gamma %.2f)." % gamma)
+    lines.append(" *")
+    lines.append(" * @{")
+    lines.append(" */")
+    lines.append("")
+    lines.append("/* ---------------- #includes needed for this file ----------------- */")
+    lines.append("#include \"leds.h\"")
+    lines.append("")
+    lines.append("/* ----------------- Definition of public variables --------------------- */")
+    lines.append("")
+    lines.append("/* Perceptual level to gamma corrected PWM duty */")
+    lines.append("const uint8_t ledsGammaLut[256] __attribute__((section(\".ledlut\"))) = {")
+    table = gamma_table(gamma)
+    for row in range(0, 256, 16):
+        values = ", ".join("%3d" % v for v in table[row:row + 16])
+        lines.append("    %s," % values)
+    lines.append("};")
+    lines.append("")
+    lines.append("/* HSV sector to {v, p, q, t} selector for the red, green and blue channels */")
+    lines.append("const uint8_t ledsHsvSectorLut[6][3] __attribute__((section(\".ledlut\"))) = {")
+    for sector in HSV_SECTORS:
+        lines.append("    {%d, %d, %d}," % sector)
+    lines.append("};")
+    lines.append("")
+    lines.append("/* @} */")
+    lines.append("")
+    with open(path, "w", newline="\r\n") as out:
+        out.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.stderr.write("usage: ledlut.py <output.c> [gamma]\n")
+        sys.exit(1)
+    emit(sys.argv[1], float(sys.argv[2]) if len(sys.argv) > 2 else DEFAULT_GAMMA)
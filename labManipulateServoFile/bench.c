@@ -0,0 +1,85 @@
+/**
+* @file bench.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Throughput benchmark of the startup profiles
+*
+* The planner goes back and forth between 0 and 180 with the S-curve on, so
+* every step runs the trapezoid and the moving average. Its result goes to a
+* volatile so the compiler cannot drop the loop.
+*
+* A second pass times every step on its own for the worst case, less the
+* cost of two back to back counter reads.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/inc/msp.h>
+#include "bench.h"
+#include "motion.h"
+#include "critical.h"
+
+/* SECTION 2: Private macros */
+
+/* SECTION 3: Private types */
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+static volatile int32_t _benchSink ; /**< Keeps the planner output alive */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+void benchRun ( bench_result_t *r ) {
+    motion_t m;
+    uint32_t i, start, cycles, overhead, one, max;
+    critical_t s;
+
+    motionInit (&m, 0);
+    motionSetLimits (&m, 360, 1440, 7200 );
+
+    CoreDebug -> DEMCR |= CoreDebug_DEMCR_TRCENA_Msk ;
+    DWT -> CTRL |= DWT_CTRL_CYCCNTENA_Msk ;
+
+    s = criticalEnter ();
+    start = DWT -> CYCCNT ;
+    for ( i = 0; i < BENCH_STEPS; i++ ){
+        if ( motionIsDone (&m )){
+            motionMoveTo (&m, ( motionGetPosition (&m ) == 0) ? 180 : 0);
+        }
+        _benchSink = motionStep (&m );
+    }
+    cycles = DWT -> CYCCNT - start;
+
+    start = DWT -> CYCCNT ;
+    overhead = DWT -> CYCCNT - start;
+    max = 0;
+    for ( i = 0; i < BENCH_STEPS; i++ ){
+        if ( motionIsDone (&m )){
+            motionMoveTo (&m, ( motionGetPosition (&m ) == 0) ? 180 : 0);
+        }
+        start = DWT -> CYCCNT ;
+        _benchSink = motionStep (&m );
+        one = DWT -> CYCCNT - start - overhead;
+        if ( one > max ){
+            max = one;
+        }
+    }
+    criticalExit (s);
+
+    r->mclk_hz = SystemCoreClock ;
+    r->cycles = cycles;
+    r->cycles_per_step = ( cycles + BENCH_STEPS / 2) / BENCH_STEPS ;
+    r->cycles_step_max = max;
+    r->steps_per_s = ( uint32_t )(( uint64_t ) SystemCoreClock * BENCH_STEPS / cycles );
+}
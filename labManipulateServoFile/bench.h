@@ -0,0 +1,55 @@
+/**
+* @file bench.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Throughput benchmark of the startup profiles
+*
+* Main characteristics of this module :
+* - The workload is the servo motion planner : BENCH_STEPS S-curve steps of
+* motion.c. motionStep () and the kernels it calls are RAMFUNC, so they run
+* from SRAM, unless RAMFUNC_DISABLE is defined: then they run from flash
+* like the rest of the program
+* - Cycles are counted by the DWT cycle counter with interrupts masked . The
+* cycles per step show the flash wait states and read buffering , the steps
+* per second add the clock: together they compare the profiles of
+* system_msp432p401r.c ( __STARTUP_PROFILE ), one build per profile
+* - One step is one frame of a servo: cycles_per_step is the average cost of
+* a frame and cycles_step_max the worst one seen, to hold against the few
+* hundred cycles motion.h promises
+* - Before / after comparison of the SRAM code: build with MAIN_BENCH, run
+* and read benchResult, then the same with RAMFUNC_DISABLE added. At 48 MHz
+* ( profile 1 ) flash needs wait states and the gap is largest
+*
+*/
+#ifndef BENCH_H
+#define BENCH_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define BENCH_STEPS 10000 /**< Planner steps per run */
+/* SECTION 3: Public types */
+
+/**
+* @brief Result of one run
+*/
+
+typedef struct {
+    uint32_t mclk_hz ; /**< MCLK during the run */
+    uint32_t cycles ; /**< MCLK cycles for BENCH_STEPS steps */
+    uint32_t cycles_per_step ; /**< Rounded, the planner cost of one frame */
+    uint32_t cycles_step_max ; /**< Slowest single step , the bound of one frame */
+    uint32_t steps_per_s ; /**< Throughput */
+} bench_result_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Run the benchmark ( foreground, interrupts masked for a while )
+*/
+
+void benchRun ( bench_result_t *r );
+
+#endif // BENCH_H
@@ -13,6 +13,8 @@
 
 /* ---------------- #includes needed for this file ----------------- */
 #include "buttons.h"
+#include "ramfunc.h"
+#include "critical.h"
 
 /* --------------------------- Private macros ----------------------------- */
 #define NUM_BUTTONS (sizeof(buttonsPinRef) / sizeof(input_pinref_t))
@@ -46,7 +48,7 @@ static int _buttonInverseSearch(uint16_t int_num, uint8_t mask);
 void buttonCallback(int button_index) __attribute__((weak));
 
 /* --------- Implementation of private functions (with static) ------------ */
-static int _IVBitmask(int port){
+RAMFUNC static int _IVBitmask(int port){
     switch(port){
     case 0x00:
         return -1;
@@ -83,6 +85,9 @@ static int _IVBitmask(int port){
 
 static void _buttonInit(const input_pinref_t *ref)
 {
+    // The port registers are shared with the other drivers of the port, the
+    // read-modify-writes must not interleave with theirs
+    critical_t s = criticalEnter();
     if (ref->port_is_odd)
     {
         ref->odd->SEL0 &= ~(ref->mask);
@@ -119,9 +124,10 @@ static void _buttonInit(const input_pinref_t *ref)
             Interrupt_enableInterrupt(ref->int_num);
         }
     }
+    criticalExit(s);
 }
 
-static int _buttonInverseSearch(uint16_t int_num, uint8_t mask)
+RAMFUNC static int _buttonInverseSearch(uint16_t int_num, uint8_t mask)
 {
     int i;
     for(i = 0; i < NUM_BUTTONS; i++){
@@ -131,7 +137,7 @@ static int _buttonInverseSearch(uint16_t int_num, uint8_t mask)
     return -1;
 }
 
-void PORT1_IRQHandler(void){
+RAMFUNC void PORT1_IRQHandler(void){
     uint16_t int_num = INT_PORT1;
     uint16_t port = P1->IV;
     int bitmask = _IVBitmask(port);
@@ -140,7 +146,7 @@ void PORT1_IRQHandler(void){
         buttonCallback(button_num);
     }
 }
-void PORT2_IRQHandler(void){
+RAMFUNC void PORT2_IRQHandler(void){
     uint16_t int_num = INT_PORT2;
     uint16_t port = P2->IV;
     int bitmask = _IVBitmask(port);
@@ -149,7 +155,7 @@ void PORT2_IRQHandler(void){
         buttonCallback(button_num);
     }
 }
-void PORT3_IRQHandler(void){
+RAMFUNC void PORT3_IRQHandler(void){
     uint16_t int_num = INT_PORT3;
     uint16_t port = P3->IV;
     int bitmask = _IVBitmask(port);
@@ -158,7 +164,7 @@ void PORT3_IRQHandler(void){
         buttonCallback(button_num);
     }
 }
-void PORT4_IRQHandler(void){
+RAMFUNC void PORT4_IRQHandler(void){
     uint16_t int_num = INT_PORT4;
     uint16_t port = P4->IV;
     int bitmask = _IVBitmask(port);
@@ -167,7 +173,7 @@ void PORT4_IRQHandler(void){
         buttonCallback(button_num);
     }
 }
-void PORT5_IRQHandler(void){
+RAMFUNC void PORT5_IRQHandler(void){
     uint16_t int_num = INT_PORT5;
     uint16_t port = P5->IV;
     int bitmask = _IVBitmask(port);
@@ -176,7 +182,7 @@ void PORT5_IRQHandler(void){
         buttonCallback(button_num);
     }
 }
-void PORT6_IRQHandler(void){
+RAMFUNC void PORT6_IRQHandler(void){
     uint16_t int_num = INT_PORT6;
     uint16_t port = P6->IV;
     int bitmask = _IVBitmask(port);
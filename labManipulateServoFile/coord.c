@@ -0,0 +1,279 @@
+/**
+* @file coord.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Coordinated moves of the mservo channels with synchronised arrival
+*
+* The profile of a move is planned as whole frames: s gains a per frame for
+* na frames, keeps its velocity for nc frames and loses a per frame for
+* na - 1 frames. The distance is a * na * (na + nc), so a = 1 / (na * (na + nc))
+* and the move lasts exactly 2 na - 1 + nc frames. With the path limits
+* Vf ( s per frame ) and Af ( s per frame ^2) of the slowest axis:
+* - triangle ( nc = 0 ) if na = ceil ( sqrt (1 / Af )) also gives 1 / na <= Vf
+* - else m = na + nc = ceil (1 / Vf ) and na = ceil ((1 / Af ) / m)
+*
+* s and its velocity are Q48 so that long moves ( small a ) do not lose
+* precision , and s is forced to 1 on the last frame.
+*
+* The moves are handed from coordMove () to coordFrame () through a ring with
+* one producer and one consumer, a __DMB () between every slot access and
+* the index that hands the slot over.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/inc/msp.h>
+#include "coord.h"
+#include "servo.h"
+
+/* SECTION 2: Private macros */
+#define COORD_SHIFT 48 /**< Fractional bits of s */
+#define COORD_ONE (1ULL << COORD_SHIFT ) /**< s at the end of a move */
+#define COORD_QUEUE_MASK ( COORD_QUEUE_LEN - 1)
+#define COORD_FRAME_HZ SERVO_FRAME_HZ /**< mservo frames per second */
+
+/* SECTION 3: Private types */
+/**
+* @brief A planned move
+*/
+
+typedef struct {
+    int32_t delta [ COORD_MAX_AXES ]; /**< Distance of every axis (0.01 degrees ) */
+    uint64_t a ; /**< Acceleration of s, Q48 per frame ^2 */
+    uint16_t na ; /**< Frames of acceleration */
+    uint16_t nc ; /**< Frames at constant velocity */
+    uint8_t blend ; /**< Flag (0/1), starts while the previous one decelerates */
+} coord_move_t ;
+
+/**
+* @brief A move being played
+*/
+
+typedef struct {
+    coord_move_t m ;
+    uint64_t s ; /**< Progress , Q48, 0 to COORD_ONE */
+    uint64_t v ; /**< Velocity of s, Q48 per frame */
+    uint16_t k ; /**< Frames played */
+} coord_run_t ;
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+static coord_move_t _coordQueue [ COORD_QUEUE_LEN ];
+static volatile uint8_t _coordHead ; /**< Next slot to write, coordMove () only */
+static volatile uint8_t _coordTail ; /**< Next slot to read, coordFrame () only */
+static coord_run_t _coordRun [2]; /**< Move being played and move blending in */
+static volatile uint8_t _coordRunning ; /**< Entries of _coordRun in use */
+static int32_t _coordBase [ COORD_MAX_AXES ]; /**< Start of _coordRun [0] ( frame ) */
+static int32_t _coordPlanned [ COORD_MAX_AXES ]; /**< End of the last queued move ( foreground ) */
+static uint32_t _coordVmax [ COORD_MAX_AXES ]; /**< 0.01 degrees / s */
+static uint32_t _coordAmax [ COORD_MAX_AXES ]; /**< 0.01 degrees / s^2 */
+static uint8_t _coordAxes ; /**< Axes in use, mservoGetNum () */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Integer square root , rounded down
+*/
+
+static uint32_t _coordSqrt ( uint64_t x );
+
+/**
+* @brief Frames of a move
+*/
+
+static uint16_t _coordFrames ( const coord_move_t *m );
+
+/**
+* @brief Advance the profile of a move one frame
+*/
+
+static void _coordStep ( coord_run_t *r );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+static uint32_t _coordSqrt ( uint64_t x ) {
+    uint64_t r = 0, bit = 1ULL << 62;
+    while ( bit > x ){
+        bit >>= 2;
+    }
+    while ( bit ){
+        if ( x >= r + bit ){
+            x -= r + bit;
+            r = ( r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return ( uint32_t ) r;
+}
+
+static uint16_t _coordFrames ( const coord_move_t *m ) {
+    return 2 * m->na - 1 + m->nc;
+}
+
+static void _coordStep ( coord_run_t *r ) {
+    uint16_t frames = _coordFrames (& r->m );
+    if ( r->k >= frames ){
+        return;
+    }
+    r->k++;
+    if ( r->k <= r->m.na ){
+        r->v += r->m.a;
+    } else if ( r->k > r->m.na + r->m.nc ){
+        r->v -= r->m.a;
+    }
+    r->s += r->v;
+    if ( r->k == frames ){
+        r->s = COORD_ONE; // Rounding of a, below one Q48 unit per frame
+    }
+}
+
+void coordInit ( void ) {
+    uint8_t i;
+    _coordAxes = mservoGetNum ();
+    _coordRunning = 0;
+    _coordHead = 0;
+    _coordTail = 0;
+    for ( i = 0; i < _coordAxes; i++ ){
+        _coordBase [i] = mservoGetPositionCd ( i );
+        _coordPlanned [i] = _coordBase [i];
+        coordSetLimits ( i, 90, 360 );
+    }
+}
+
+void coordSetLimits ( uint8_t axis, uint32_t vmax, uint32_t amax ) {
+    if ( axis < COORD_MAX_AXES ){
+        _coordVmax [ axis ] = vmax ? vmax * SERVO_POS_SCALE : 1;
+        _coordAmax [ axis ] = amax ? amax * SERVO_POS_SCALE : 1;
+    }
+}
+
+int coordMove ( const uint32_t *target, uint8_t blend ) {
+    uint8_t head = _coordHead, i;
+    coord_move_t *mv;
+    uint64_t inv_a = 0, inv_v = 0, q;
+    uint32_t d, na, nc, m, t;
+
+    if (( uint8_t )( head - _coordTail ) >= COORD_QUEUE_LEN ){
+        return -1;
+    }
+    // The slot is not written before the tail read says it is free
+    __DMB ();
+    mv = & _coordQueue [ head & COORD_QUEUE_MASK ];
+    // Path limits of the slowest axis, as 1 / Af ( frames ^2) and 1 / Vf
+    // ( frames ), both Q16
+    for ( i = 0; i < _coordAxes; i++ ){
+        t = ( target [i] > SERVO_POS_MAX ) ? SERVO_POS_MAX : target [i];
+        mv->delta [i] = ( int32_t ) t - _coordPlanned [i];
+        _coordPlanned [i] = t;
+        d = ( mv->delta [i] < 0) ? - mv->delta [i] : mv->delta [i];
+        q = ((( uint64_t ) d * COORD_FRAME_HZ * COORD_FRAME_HZ ) << 16) / _coordAmax [i];
+        if ( q > inv_a ){
+            inv_a = q;
+        }
+        q = ((( uint64_t ) d * COORD_FRAME_HZ ) << 16) / _coordVmax [i];
+        if ( q > inv_v ){
+            inv_v = q;
+        }
+    }
+    // Triangle first , trapezoid if the peak velocity is too high
+    na = ( _coordSqrt ( inv_a << 16) + 0xFFFF ) >> 16;
+    if ( na == 0 ){
+        na = 1;
+    }
+    nc = 0;
+    if ((( uint64_t ) na << 16) < inv_v ){
+        m = ( uint32_t )(( inv_v + 0xFFFF ) >> 16);
+        na = ( uint32_t )(( inv_a + (( uint64_t ) m << 16) - 1) / (( uint64_t ) m << 16));
+        if ( na == 0 ){
+            na = 1;
+        }
+        if ( na > m ){
+            na = m;
+        }
+        nc = m - na;
+    }
+    // Over 10 minutes, the limits are not met any more
+    if ( na > 0x7FFF ){
+        na = 0x7FFF;
+    }
+    if ( na + nc > 0x7FFF ){
+        nc = 0x7FFF - na;
+    }
+    mv->na = ( uint16_t ) na;
+    mv->nc = ( uint16_t ) nc;
+    mv->a = COORD_ONE / (( uint64_t ) na * ( na + nc ));
+    mv->blend = blend;
+    // Publish the slot only once it is complete: the barrier keeps the
+    // compiler and the bus from moving the slot stores after the index store
+    __DMB ();
+    _coordHead = head + 1;
+    return 0;
+}
+
+int coordIsDone ( void ) {
+    // Tail first , coordFrame () counts a move as running before it frees its slot
+    uint8_t tail = _coordTail;
+    return ( tail == _coordHead ) && ( _coordRunning == 0);
+}
+
+void coordFrame ( void ) {
+    uint8_t i, j, tail = _coordTail;
+    coord_run_t *r;
+    int64_t pos;
+
+    // Start the next move when nothing runs, or blend it in as soon as the
+    // one running decelerates
+    if (( _coordRunning < 2) && ( tail != _coordHead )){
+        const coord_move_t *next = & _coordQueue [ tail & COORD_QUEUE_MASK ];
+        // No slot read before the index read
+        __DMB ();
+        r = & _coordRun [0];
+        if (( _coordRunning == 0) ||
+            ( next->blend && ( r->k >= r->m.na + r->m.nc ))){
+            r = & _coordRun [ _coordRunning ];
+            r->m = *next;
+            r->s = 0;
+            r->v = 0;
+            r->k = 0;
+            // Running first : coordIsDone () reads the tail first. The slot
+            // is copied before the tail frees it
+            _coordRunning++;
+            __DMB ();
+            _coordTail = tail + 1;
+        }
+    }
+    if ( _coordRunning == 0 ){
+        return;
+    }
+    for ( j = 0; j < _coordRunning; j++ ){
+        _coordStep (& _coordRun [j] );
+    }
+    // One multiplication per axis and move
+    for ( i = 0; i < _coordAxes; i++ ){
+        pos = _coordBase [i];
+        for ( j = 0; j < _coordRunning; j++ ){
+            pos += (( int64_t ) _coordRun [j].m.delta [i] * ( int64_t )( _coordRun [j].s >> 18)) >> 30;
+        }
+        mservoSetAbsPositionCd ( i, ( pos < 0) ? 0 : ( uint32_t ) pos );
+    }
+    // The first move is over: its end is the start of the next one
+    r = & _coordRun [0];
+    if ( r->k >= _coordFrames (& r->m )){
+        for ( i = 0; i < _coordAxes; i++ ){
+            _coordBase [i] += r->m.delta [i];
+        }
+        _coordRun [0] = _coordRun [1];
+        _coordRunning--;
+    }
+}
@@ -0,0 +1,75 @@
+/**
+* @file coord.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Coordinated moves of the mservo channels with synchronised arrival
+*
+* Main characteristics of this module :
+* - A move gives a target to every axis ( mservo channel ). All the axes
+* start in the same frame and arrive in the same frame: they follow one
+* common profile s (0 to 1) and axis i is at start_i + delta_i * s
+* - The profile of s is a trapezoid in frames, planned by coordMove () in
+* the foreground from the slowest axis: the velocity and acceleration limit
+* of every axis, divided by its distance , limits s
+* - A move queued with blend starts while the previous one decelerates, the
+* two profiles add up and the axes go through without stopping
+* - coordFrame () is the only per-frame work: one profile step per active
+* move and one multiplication per axis and active move. No division
+* - The application calls coordFrame () from mservoFrameCallback ()
+*
+*/
+#ifndef COORD_H
+#define COORD_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+#include "mservo.h"
+/* SECTION 2: Public macros */
+#define COORD_MAX_AXES MSERVO_MAX_CHANNELS /**< Axes of a move */
+#define COORD_QUEUE_LEN 4 /**< Moves waiting to start, must be a power of two */
+/* SECTION 3: Public types */
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize the module, after mservoInit ()
+* The axes start from the current mservo positions, limits 90 degrees / s and
+* 360 degrees / s^2
+*/
+
+void coordInit ( void );
+
+/**
+* @brief Set the limits of an axis
+* @param [in] axis mservo channel
+* @param [in] vmax Max velocity ( degrees / s )
+* @param [in] amax Max acceleration ( degrees / s^2)
+*/
+
+void coordSetLimits ( uint8_t axis, uint32_t vmax, uint32_t amax );
+
+/**
+* @brief Queue a coordinated move ( foreground )
+* @param [in] target Target of every axis (0.01 degrees ), mservoGetNum () entries
+* @param [in] blend Flag (0/1), start while the previous move decelerates
+* @return 0 if queued , -1 if the queue is full
+*/
+
+int coordMove ( const uint32_t *target, uint8_t blend );
+
+/**
+* @brief Flag (0/1), no move is running or queued
+*/
+
+int coordIsDone ( void );
+
+/**
+* @brief Step the moves one frame and set the mservo positions
+* To be called from mservoFrameCallback ()
+*/
+
+void coordFrame ( void );
+
+#endif // COORD_H
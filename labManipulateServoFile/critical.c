@@ -0,0 +1,41 @@
+/**
+* @file critical.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Nestable critical sections with saved interrupt state
+*
+* The sections themselves are inline in critical.h. This file only holds
+* the nesting depth of CRITICAL_DEBUG builds and the emulated masks of the
+* simulator build, and is empty otherwise.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include "critical.h"
+
+/* SECTION 2: Private macros */
+
+/* SECTION 3: Private types */
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+#ifdef CRITICAL_DEBUG
+volatile uint32_t criticalDepth ;
+#endif
+#ifdef CRITICAL_SIM
+volatile uint32_t criticalSimPrimask ;
+volatile uint32_t criticalSimBasepri ;
+#endif
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
@@ -0,0 +1,174 @@
+/**
+* @file critical.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Nestable critical sections with saved interrupt state
+*
+* Main characteristics of this module :
+* - criticalEnter () saves PRIMASK and masks every interrupt, criticalExit ()
+* puts the saved value back: a section inside another one, or entered from
+* an ISR or with the interrupts already off, never unmasks early
+* - criticalEnterLevel () does the same with BASEPRI for one prio.h level
+* and the levels below, the more urgent levels still preempt
+* - Inline functions : on the target a section is MRS, CPSID ( or MSR
+* BASEPRI_MAX ) on entry and one MSR on exit
+* - Simulator build ( host compiler , or CRITICAL_SIM defined ): PRIMASK and
+* BASEPRI are variables and CRITICAL_DEBUG is on
+* - With CRITICAL_DEBUG the saved state also holds the nesting depth, and
+* every exit asserts that it closes the innermost open section and that
+* nothing unmasked the interrupts inside it
+*
+*/
+#ifndef CRITICAL_H
+#define CRITICAL_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+#include "prio.h"
+#if ! defined ( __TI_COMPILER_VERSION__ ) && ! defined ( __arm__ ) && ! defined ( CRITICAL_SIM )
+#define CRITICAL_SIM /**< Not compiled for the MSP432 : emulate the masks */
+#endif
+#ifdef CRITICAL_SIM
+#ifndef CRITICAL_DEBUG
+#define CRITICAL_DEBUG
+#endif
+#else
+#include <ti/devices/msp432p4xx/inc/msp.h>
+#endif
+#ifdef CRITICAL_DEBUG
+#include <assert.h>
+#endif
+/* SECTION 2: Public macros */
+#define CRITICAL_DEPTH_SHIFT 8 /**< Saved state : mask in bits 7:0, CRITICAL_DEBUG depth above */
+#define CRITICAL_MASK_BITS ((1UL << CRITICAL_DEPTH_SHIFT ) - 1) /**< Saved state : mask bits */
+/* SECTION 3: Public types */
+
+/**
+* @brief Interrupt state saved by criticalEnter () or criticalEnterLevel ()
+*/
+
+typedef uint32_t critical_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+#ifdef CRITICAL_DEBUG
+extern volatile uint32_t criticalDepth ; /**< Sections open, all contexts */
+#endif
+#ifdef CRITICAL_SIM
+extern volatile uint32_t criticalSimPrimask ; /**< Emulated PRIMASK */
+extern volatile uint32_t criticalSimBasepri ; /**< Emulated BASEPRI */
+#endif
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+#ifdef CRITICAL_SIM
+static inline uint32_t _criticalGetPrimask ( void ) { return criticalSimPrimask; }
+static inline void _criticalSetPrimask ( uint32_t m ) { criticalSimPrimask = m & 1; }
+static inline void _criticalDisable ( void ) { criticalSimPrimask = 1; }
+static inline uint32_t _criticalGetBasepri ( void ) { return criticalSimBasepri; }
+static inline void _criticalSetBasepri ( uint32_t b ) { criticalSimBasepri = b & 0xFF; }
+static inline void _criticalSetBasepriMax ( uint32_t b ) {
+    if (( b != 0) && (( criticalSimBasepri == 0) || ( b < criticalSimBasepri ))){
+        criticalSimBasepri = b;
+    }
+}
+#else
+static inline uint32_t _criticalGetPrimask ( void ) { return __get_PRIMASK (); }
+static inline void _criticalSetPrimask ( uint32_t m ) { __set_PRIMASK ( m ); }
+static inline void _criticalDisable ( void ) { __disable_irq (); }
+static inline uint32_t _criticalGetBasepri ( void ) { return __get_BASEPRI (); }
+static inline void _criticalSetBasepri ( uint32_t b ) { __set_BASEPRI ( b ); }
+static inline void _criticalSetBasepriMax ( uint32_t b ) { __set_BASEPRI_MAX ( b ); }
+#endif
+
+#ifdef CRITICAL_DEBUG
+/**
+* @brief Add the depth of the section being opened to a saved state
+*/
+
+static inline critical_t _criticalPush ( critical_t s ) {
+    return s | ( critical_t )(++ criticalDepth ) << CRITICAL_DEPTH_SHIFT ;
+}
+
+/**
+* @brief Check the section being closed and drop the depth from its state
+*/
+
+static inline critical_t _criticalPop ( critical_t s ) {
+    // Sections close innermost first, each one exactly once
+    assert (( s >> CRITICAL_DEPTH_SHIFT ) == criticalDepth );
+    criticalDepth--;
+    return s & CRITICAL_MASK_BITS ;
+}
+#endif
+
+/**
+* @brief Mask every interrupt
+* @return State to give to criticalExit ()
+*/
+
+static inline critical_t criticalEnter ( void ) {
+    critical_t s = _criticalGetPrimask ();
+    _criticalDisable ();
+#ifdef CRITICAL_DEBUG
+    s = _criticalPush ( s );
+#endif
+    return s;
+}
+
+/**
+* @brief Restore the state saved by the matching criticalEnter ()
+*/
+
+static inline void criticalExit ( critical_t s ) {
+#ifdef CRITICAL_DEBUG
+    // Nothing inside the section may unmask
+    assert ( _criticalGetPrimask () != 0);
+    s = _criticalPop ( s );
+#endif
+    _criticalSetPrimask ( s );
+}
+
+/**
+* @brief Mask the interrupts of a preemption level and of the levels below
+* @param [in] level 1 to 3, the interrupts of level - 1 and above still run
+* @return State to give to criticalExitLevel ()
+* A mask already stricter is kept. Level 0 can only be masked with
+* criticalEnter (): a BASEPRI of 0 masks nothing
+*/
+
+static inline critical_t criticalEnterLevel ( uint8_t level ) {
+    critical_t s = _criticalGetBasepri ();
+#ifdef CRITICAL_DEBUG
+    assert (( level >= 1) && ( level <= 3));
+#endif
+    _criticalSetBasepriMax (( uint32_t ) level << PRIO_SHIFT );
+#ifdef CRITICAL_DEBUG
+    s = _criticalPush ( s );
+#endif
+    return s;
+}
+
+/**
+* @brief Restore the state saved by the matching criticalEnterLevel ()
+*/
+
+static inline void criticalExitLevel ( critical_t s ) {
+#ifdef CRITICAL_DEBUG
+    assert ( _criticalGetBasepri () != 0);
+    s = _criticalPop ( s );
+#endif
+    _criticalSetBasepri ( s );
+}
+
+#ifdef CRITICAL_SIM
+/**
+* @brief Simulator : an interrupt of this priority would be taken now
+* @param [in] prio PRIO () of the interrupt
+*/
+
+static inline int criticalSimIrqAllowed ( uint8_t prio ) {
+    return ( criticalSimPrimask == 0) && (( criticalSimBasepri == 0) || ( prio < criticalSimBasepri ));
+}
+#endif
+
+#endif // CRITICAL_H
@@ -0,0 +1,193 @@
+/**
+* @file freq.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Run-time scaling of the DCO frequency with clock change notification
+*
+* Every step must be valid for both the old and the new frequency, so the
+* order depends on the direction:
+* - faster : core voltage up, flash wait states up, SMCLK divider, DCO
+* - slower : DCO, SMCLK divider, flash wait states down, core voltage down
+* The levels, wait states and read buffering are the ones SystemInit () uses
+* for the same frequency. Read buffering is only ever added : a startup
+* profile may have enabled it for every frequency.
+*
+* The DC-DC regulator cannot change the core voltage itself: the transition
+* goes through the LDO at the current level and comes back to the DC-DC.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "freq.h"
+
+/* SECTION 2: Private macros */
+#define FREQ_NUM_LEVELS (sizeof ( _freqLevels ) / sizeof ( freq_level_t )) /**< Frequencies offered */
+#define FREQ_AMR_DCDC PCM_CTL0_AMR_4 /**< Active mode request : DC-DC bit */
+
+/* SECTION 3: Private types */
+/**
+* @brief Settings of one DCO frequency
+*/
+
+typedef struct {
+    uint32_t hz ; /**< MCLK */
+    uint32_t dcorsel ; /**< CS CTL0 DCO range */
+    uint32_t divs ; /**< CS CTL1 SMCLK divider */
+    uint8_t vcore ; /**< Core voltage level, 0 or 1 */
+    uint8_t wait ; /**< Flash wait states */
+    uint8_t buf0 ; /**< Flag (0/1), bank 0 read buffering */
+    uint8_t buf1 ; /**< Flag (0/1), bank 1 read buffering */
+} freq_level_t ;
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+/** Centred DCO frequencies , slowest first */
+static const freq_level_t _freqLevels [] = {
+    { .hz = 1500000, .dcorsel = CS_CTL0_DCORSEL_0 , .divs = CS_CTL1_DIVS__1 , .vcore = 0, .wait = 0, .buf0 = 0, .buf1 = 0 },
+    { .hz = 3000000, .dcorsel = CS_CTL0_DCORSEL_1 , .divs = CS_CTL1_DIVS__1 , .vcore = 0, .wait = 0, .buf0 = 0, .buf1 = 0 },
+    { .hz = 6000000, .dcorsel = CS_CTL0_DCORSEL_2 , .divs = CS_CTL1_DIVS__1 , .vcore = 0, .wait = 0, .buf0 = 0, .buf1 = 0 },
+    { .hz = 12000000, .dcorsel = CS_CTL0_DCORSEL_3 , .divs = CS_CTL1_DIVS__1 , .vcore = 0, .wait = 0, .buf0 = 0, .buf1 = 0 },
+    // BANK0 VCORE0 max is 12 MHz without wait states
+    { .hz = 24000000, .dcorsel = CS_CTL0_DCORSEL_4 , .divs = CS_CTL1_DIVS__1 , .vcore = 0, .wait = 1, .buf0 = 1, .buf1 = 0 },
+    // VCORE1 is mandatory for 48 MHz, SMCLK max is 24 MHz
+    { .hz = 48000000, .dcorsel = CS_CTL0_DCORSEL_5 , .divs = CS_CTL1_DIVS__2 , .vcore = 1, .wait = 1, .buf0 = 1, .buf1 = 1 },
+};
+
+static freq_notify_t _freqSubscribers [ FREQ_MAX_SUBSCRIBERS ];
+static uint8_t _freqNumSubscribers ;
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Request an active mode from the PCM and wait for it
+*/
+
+static void _freqPcm ( uint32_t amr );
+
+/**
+* @brief Move the core voltage to a level, keeping the regulator
+*/
+
+static void _freqSetVcore ( uint8_t vcore );
+
+/**
+* @brief Flash wait states and read buffering of a level
+*/
+
+static void _freqSetFlash ( const freq_level_t *to );
+
+/**
+* @brief DCO range and SMCLK divider of a level
+* @param [in] up Flag (0/1), the new frequency is the higher one
+*/
+
+static void _freqSetDco ( const freq_level_t *to, uint8_t up );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+static void _freqPcm ( uint32_t amr ) {
+    while ( PCM -> CTL1 & PCM_CTL1_PMR_BUSY );
+    PCM -> CTL0 = PCM_CTL0_KEY_VAL | amr ;
+    while ( PCM -> CTL1 & PCM_CTL1_PMR_BUSY );
+}
+
+static void _freqSetVcore ( uint8_t vcore ) {
+    uint32_t cpm = ( PCM -> CTL0 & PCM_CTL0_CPM_MASK ) >> PCM_CTL0_CPM_OFS ;
+    if (( cpm & PCM_CTL0_AMR_1 ) == vcore ){
+        return;
+    }
+    if ( cpm & FREQ_AMR_DCDC ){
+        _freqPcm ( cpm & PCM_CTL0_AMR_1 );
+        _freqPcm ( vcore );
+        _freqPcm ( FREQ_AMR_DCDC | vcore );
+    } else {
+        _freqPcm ( vcore );
+    }
+}
+
+static void _freqSetFlash ( const freq_level_t *to ) {
+    uint32_t wait = to->wait ? FLCTL_BANK0_RDCTL_WAIT_1 : FLCTL_BANK0_RDCTL_WAIT_0 ;
+    uint32_t r0, r1;
+
+    r0 = ( FLCTL -> BANK0_RDCTL & ~ FLCTL_BANK0_RDCTL_WAIT_MASK ) | wait ;
+    r1 = ( FLCTL -> BANK1_RDCTL & ~ FLCTL_BANK1_RDCTL_WAIT_MASK ) | wait ;
+    if ( to->buf0 ){
+        r0 |= FLCTL_BANK0_RDCTL_BUFD | FLCTL_BANK0_RDCTL_BUFI ;
+    }
+    if ( to->buf1 ){
+        r1 |= FLCTL_BANK1_RDCTL_BUFD | FLCTL_BANK1_RDCTL_BUFI ;
+    }
+    FLCTL -> BANK0_RDCTL = r0;
+    FLCTL -> BANK1_RDCTL = r1;
+}
+
+static void _freqSetDco ( const freq_level_t *to, uint8_t up ) {
+    uint32_t ctl1;
+
+    CS -> KEY = CS_KEY_VAL ; // Unlock CS module for register access
+    // MCLK and SMCLK from the DCO, undivided but for SMCLK at 48 MHz. The
+    // divider goes up before the DCO and down after it, SMCLK never exceeds
+    // the higher of its two values
+    ctl1 = ( CS -> CTL1 & ~( CS_CTL1_SELM_MASK | CS_CTL1_DIVM_MASK | CS_CTL1_SELS_MASK | CS_CTL1_DIVS_MASK ))
+        | CS_CTL1_SELM__DCOCLK | CS_CTL1_SELS__DCOCLK | to->divs ;
+    if ( up ){
+        CS -> CTL1 = ctl1;
+        CS -> CTL0 = to->dcorsel ;
+    } else {
+        CS -> CTL0 = to->dcorsel ;
+        CS -> CTL1 = ctl1;
+    }
+    CS -> KEY = 0;
+}
+
+int freqSet ( uint32_t hz ) {
+    const freq_level_t *to = 0;
+    uint8_t i, up;
+
+    for ( i = 0; i < FREQ_NUM_LEVELS; i++ ){
+        if ( _freqLevels [i].hz == hz ){
+            to = & _freqLevels [i];
+        }
+    }
+    if (! to ){
+        return -1;
+    }
+    up = ( hz > SystemCoreClock ) ? 1 : 0;
+    if ( up ){
+        _freqSetVcore ( to->vcore );
+        _freqSetFlash ( to );
+        _freqSetDco ( to, 1 );
+    } else {
+        _freqSetDco ( to, 0 );
+        _freqSetFlash ( to );
+        _freqSetVcore ( to->vcore );
+    }
+    SystemCoreClock = hz;
+
+    for ( i = 0; i < _freqNumSubscribers; i++ ){
+        _freqSubscribers [i] ();
+    }
+    return 0;
+}
+
+uint32_t freqGet ( void ) {
+    return SystemCoreClock;
+}
+
+int freqSubscribe ( freq_notify_t fn ) {
+    if ( _freqNumSubscribers >= FREQ_MAX_SUBSCRIBERS ){
+        return -1;
+    }
+    _freqSubscribers [ _freqNumSubscribers ++] = fn;
+    return 0;
+}
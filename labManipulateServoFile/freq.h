@@ -0,0 +1,61 @@
+/**
+* @file freq.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Run-time scaling of the DCO frequency with clock change notification
+*
+* Main characteristics of this module :
+* - freqSet () moves MCLK ( and SMCLK ) to one of the centred DCO
+* frequencies , 1.5 to 48 MHz, while the program runs. It takes the core
+* voltage ( PCM ), the flash wait states and read buffering ( FLCTL ) and the
+* DCO range through the same steps as SystemInit (), in the safe order for
+* both directions
+* - SMCLK follows MCLK, halved at 48 MHz to stay within its 24 MHz limit
+* - Modules with clock derived timing ( servoUpdateClock, mservoUpdateClock ,
+* stimeUpdateClock ) are registered with freqSubscribe () and called once
+* the new frequency is running
+* - The regulator ( LDO or DC-DC ) selected by SystemInit () is kept
+*
+*/
+#ifndef FREQ_H
+#define FREQ_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define FREQ_MAX_SUBSCRIBERS 8 /**< Functions freqSubscribe () can register */
+/* SECTION 3: Public types */
+
+/**
+* @brief Clock change notification, called from freqSet ()
+*/
+
+typedef void (* freq_notify_t )( void );
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Change the MCLK frequency ( foreground )
+* @param [in] hz 1500000, 3000000, 6000000, 12000000, 24000000 or 48000000
+* @return 0 if set, -1 if hz is not a centred DCO frequency
+* The subscribers are called in registration order before the return
+*/
+
+int freqSet ( uint32_t hz );
+
+/**
+* @brief Current MCLK frequency ( Hz )
+*/
+
+uint32_t freqGet ( void );
+
+/**
+* @brief Register a function to call after every frequency change
+* @return 0 if registered , -1 if the table is full
+*/
+
+int freqSubscribe ( freq_notify_t fn );
+
+#endif // FREQ_H
@@ -0,0 +1,81 @@
+/**
+* @file idle.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Idle governor: sleep as deep as the next deadline and the wake-up
+* latency budget allow
+*
+* Main characteristics of this module :
+* - idleEnter () replaces the empty spin of the main loop. It sleeps until
+* the next interrupt in one of three ways:
+* - IDLE_WFI : WFI with the 1 ms stime tick running, for deadlines closer
+* than IDLE_TICKLESS_MIN_MS
+* - IDLE_LPM0 : tick stopped, clocks running , woken by the RTC no later
+* than the next stime deadline
+* - IDLE_LPM3 : as IDLE_LPM0 with MCLK and SMCLK off as well. Chosen when no
+* module holds a deep sleep lock and the latency budget covers the
+* IDLE_LPM3_WAKE_US wake-up
+* - The RTC ( from REFO, 32768 Hz ) keeps time while the tick is stopped, and
+* stime is corrected with the time slept on every wake-up
+* - Modules that need SMCLK or MCLK while the CPU sleeps ( servo PWM, pulse
+* capture ) hold a lock with idleBlockDeep () / idleAllowDeep ()
+*
+*/
+#ifndef IDLE_H
+#define IDLE_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define IDLE_LPM3_WAKE_US 25 /**< LPM3 to active mode, DCO restart included ( estimate, measure on the board ) */
+#define IDLE_TICKLESS_MIN_MS 16 /**< Shortest RTC wake-up interval (15.625 ms ), rounded up */
+#define IDLE_LATENCY_DEFAULT_US 1000 /**< Wake-up latency budget after idleInit () */
+/* SECTION 3: Public types */
+
+/**
+* @brief Ways of sleeping , lightest first
+*/
+
+typedef enum {
+    IDLE_WFI , /**< Core asleep , tick running */
+    IDLE_LPM0 , /**< Core asleep , tick stopped, clocks running */
+    IDLE_LPM3 /**< Core asleep , tick stopped, only the RTC running */
+} idle_mode_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize the module: start the RTC from REFO and enable its
+* interrupt. No deep sleep lock is held
+*/
+
+void idleInit ( void );
+
+/**
+* @brief Set the wake-up latency the application tolerates ( us )
+*/
+
+void idleSetLatency ( uint32_t us );
+
+/**
+* @brief Take a deep sleep lock: LPM3 is not used while any is held
+*/
+
+void idleBlockDeep ( void );
+
+/**
+* @brief Release a lock taken with idleBlockDeep ()
+*/
+
+void idleAllowDeep ( void );
+
+/**
+* @brief Sleep until the next interrupt ( foreground, main loop )
+* @return Way of sleeping used
+*/
+
+idle_mode_t idleEnter ( void );
+
+#endif // IDLE_H
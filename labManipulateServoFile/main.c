@@ -13,26 +13,101 @@
 #include "leds.h"
 #include "buttons.h"
 #include "servo.h"
+#include "smeas.h"
+#include "stime.h"
+#include "freq.h"
+#include "idle.h"
+#include "bench.h"
+#include "prio.h"
 
+/* Build with MAIN_MEASURE defined to measure the servo pulses instead of running the sweep.
+ * Wire P2.5 (servo output) to P5.6 (TA2.1 capture) and read measureResults in the debugger */
+#define MEASURE_FRAMES 500      /* Pulses per load case (10 s) */
+#define MEASURE_WIDTH_US 1500   /* Pulse width at 90 degrees, default calibration */
+
+#ifdef MAIN_BENCH
+/* Build with MAIN_BENCH defined, once per __STARTUP_PROFILE (and with RAMFUNC_DISABLE for the
+   planner from flash), and read benchResult in the debugger */
+bench_result_t benchResult;
+#endif
+
+#ifdef MAIN_MEASURE
+/* One entry per load case: bit 0 stime running (1 ms SysTick), bit 1 button ISR kept busy */
+smeas_stats_t measureResults[4];
+
+static void measure(void)
+{
+    int load;
+
+    buttonsInit();
+    ledsInit();
+    servoSetAbsPosition(90);
+    smeasInit();
+    freqSubscribe(stimeUpdateClock);
+
+    for (load = 0; load < 4; load++)
+    {
+        if (load & 1)
+        {
+            stimeInit(CS_getMCLK());
+        }
+        else
+        {
+            stickStop();
+        }
+        smeasStart(MEASURE_WIDTH_US);
+        while (smeasGetPulses() < MEASURE_FRAMES)
+        {
+            if (load & 2)
+            {
+                /* Raise BP_S1 in software: the port ISR runs as often as the foreground can ask */
+                P5->IFG |= BIT1;
+            }
+        }
+        smeasStop();
+        smeasGetStats(&measureResults[load]);
+    }
+    stickStop();
+    while (1);
+}
+#endif
 
 int main(void)
 {
+    int32_t target = 0;     /* Next waypoint of the sweep */
+
     WDT_A_holdTimer();      /* Stop watchdog timer */
+    prioInit();             /* Interrupt priorities of all the drivers */
 
     //buttonsInit();          /* Initialize all buttons */
     //ledsInit();             /* Initialize all leds and turn them off */
 
     Interrupt_enableMaster();
 
+#ifdef MAIN_BENCH
+    benchRun(&benchResult);
+#endif
+
     servoInit();
+    freqSubscribe(servoUpdateClock);    /* Rescale the PWM on freqSet() */
+#ifdef MAIN_MEASURE
+    measure();
+#endif
+    servoTrajStart(TRAJ_CUBIC);
+
+    idleInit();
+    idleBlockDeep();        /* The PWM runs on SMCLK: LPM0 at most */
 
     while (1)
     {
-        int i;
-        for(i=100000; i>0; i--);
-        servoSetAbsPosition(0);
-        for(i=100000; i>0; i--);
-        servoSetAbsPosition(180);
+        /* Keep the trajectory queue topped up with a 0 - 180 sweep of one second per side */
+        while (trajGetFree(servoGetTrajectory()) > 0)
+        {
+            trajPush(servoGetTrajectory(), 1000, target);
+            target = SERVO_POS_MAX - target;
+        }
+        /* Nothing to do until the next servo frame */
+        idleEnter();
     }
 }
 
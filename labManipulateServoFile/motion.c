@@ -0,0 +1,252 @@
+/**
+* @file motion.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Fixed-point motion planner for servo moves
+*
+* Every frame the trapezoid looks at the distance to the target and at its
+* current velocity, and takes the fastest of accelerating, holding and
+* braking that can still stop within that distance. Since nothing is planned
+* ahead a new target simply changes the distance, which is what makes
+* retargeting in the middle of a move free.
+*
+* The stop test avoids the square root of the usual v = sqrt (2 a d): a move
+* of w this frame followed by a full brake covers w^2 / (2 a) + w / 2 when w
+* is a multiple of a, and at most a / 8 more otherwise, so w is allowed when
+* w^2 + w a + a^2 / 4 <= 2 a d, in 64 bits. With that margin braking always
+* stops before the target, never past it.
+*
+* For the S-curve the velocities of the trapezoid go through a moving average
+* of hlen = amax / jmax frames. Every acceleration step becomes a ramp of
+* hlen frames ( the jerk limit ) and the area, i.e. the distance, is kept, so
+* the output stops on the target hlen frames after the trapezoid does. The
+* rounding of the average could still step one Q16 past amax where it
+* changes sign, so the output step is clamped to amax and the excess carried
+* to the next frame like the rest of the rounding.
+*
+* The trapezoid keeps the velocity of the frame that lands on the target, and
+* stops on the next one. A retarget in between starts from that velocity ,
+* not from rest, so the velocity never changes by more than amax.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include "motion.h"
+#include "ramfunc.h"
+
+/* SECTION 2: Private macros */
+#define MOTION_ONE (1L << MOTION_SHIFT) /**< One unit in Q16 */
+
+/* SECTION 3: Private types */
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Stop at the target and report the completion
+*/
+
+static int32_t _motionArrive ( motion_t *m, int32_t target );
+
+/**
+* @brief Convert a limit per second to Q16 per frame ( divisor = frames ^ n )
+*/
+
+static int32_t _motionPerFrame ( uint32_t value, uint32_t divisor );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+static int32_t _motionPerFrame ( uint32_t value, uint32_t divisor ) {
+    int64_t q = (( int64_t ) value << MOTION_SHIFT ) / divisor;
+    // A non zero limit never rounds down to a stopped axis
+    if ( value && ( q == 0) ){
+        q = 1;
+    }
+    if ( q > INT32_MAX / 2 ){
+        q = INT32_MAX / 2;
+    }
+    return ( int32_t ) q;
+}
+
+static int32_t _motionArrive ( motion_t *m, int32_t target ) {
+    uint8_t i;
+    // Only rounding of the moving average is left, below one unit. The last
+    // velocity of the trapezoid is still in the history , already output
+    m->pos = target;
+    for ( i = 0; i < m->hlen; i++ ){
+        m->hist [i] = 0;
+    }
+    m->hsum = 0;
+    m->hrem = 0;
+    m->ovel = 0;
+    m->done = 1;
+    if ( m->done_fn ){
+        m->done_fn ( m, m->done_ctx );
+    }
+    return motionGetPosition ( m );
+}
+
+void motionInit ( motion_t *m, int32_t pos ) {
+    m->done_fn = 0;
+    m->done_ctx = 0;
+    m->hlen = 0;
+    motionJump ( m, pos );
+    motionSetLimits ( m, 90, 360, 0 );
+}
+
+void motionSetLimits ( motion_t *m, uint32_t vmax, uint32_t amax, uint32_t jmax ) {
+    int32_t jmax_q, hlen;
+    uint8_t i;
+    m->vmax = _motionPerFrame ( vmax, MOTION_FRAME_HZ );
+    m->amax = _motionPerFrame ( amax, MOTION_FRAME_HZ * MOTION_FRAME_HZ );
+    jmax_q = _motionPerFrame ( jmax, MOTION_FRAME_HZ * MOTION_FRAME_HZ * MOTION_FRAME_HZ );
+    // Frames to ramp the acceleration from 0 to amax
+    hlen = 1;
+    if ( jmax_q ){
+        hlen = ( m->amax + jmax_q / 2 ) / jmax_q;
+    }
+    if ( hlen < 1 ){
+        hlen = 1;
+    }
+    if ( hlen > MOTION_SMOOTH_MAX ){
+        hlen = MOTION_SMOOTH_MAX;
+    }
+    if ( hlen != m->hlen ){
+        // Keep the current velocity. In the middle of a move the output lag
+        // changes and the last frame absorbs the difference
+        m->hlen = ( uint8_t ) hlen;
+        m->hinv = 65536UL / hlen;
+        m->hidx = 0;
+        for ( i = 0; i < hlen; i++ ){
+            m->hist [i] = m->vel;
+        }
+        m->hsum = m->vel * hlen;
+        m->hrem = 0;
+    }
+}
+
+void motionOnDone ( motion_t *m, motion_done_t fn, void *ctx ) {
+    m->done_fn = fn;
+    m->done_ctx = ctx;
+}
+
+void motionMoveTo ( motion_t *m, int32_t target ) {
+    // Target first : the frame never sees done == 0 with the old target
+    m->target = target * MOTION_ONE;
+    m->done = 0;
+}
+
+void motionJump ( motion_t *m, int32_t pos ) {
+    uint8_t i;
+    m->done = 1;
+    m->pos = pos * MOTION_ONE;
+    m->tpos = m->pos;
+    m->target = m->pos;
+    m->vel = 0;
+    for ( i = 0; i < m->hlen; i++ ){
+        m->hist [i] = 0;
+    }
+    m->hsum = 0;
+    m->hrem = 0;
+    m->ovel = 0;
+    m->hidx = 0;
+    m->settle = 0;
+}
+
+RAMFUNC int32_t motionStep ( motion_t *m ) {
+    int32_t target, dist, dir, u, w, a, v;
+    int64_t room, avg;
+
+    if ( m->done ){
+        return motionGetPosition ( m );
+    }
+    // Work in the direction of the target: dist >= 0, u > 0 means approaching
+    target = m->target;
+    dist = target - m->tpos;
+    dir = ( dist < 0) ? -1 : 1;
+    dist *= dir;
+    u = m->vel * dir;
+    a = m->amax;
+
+    if ( u < 0 ){
+        // Moving away ( retarget ), turn back. Landing on the target stops
+        // there, a target closer than a frame of velocity is not passed
+        // again on the way back
+        w = u + a;
+        if ( w > dist ){
+            w = dist;
+        }
+    } else if (( dist <= a ) && ( u <= a )){
+        // Last step, lands on the target
+        w = dist;
+    } else if (( u <= a ) && ( dist <= 2 * a )){
+        // Slow and too close for the stop test and its margin below: the
+        // excess over a now, the last a next frame
+        w = dist - a;
+    } else {
+        // Fastest of accelerate, hold and brake that can still stop in dist
+        room = 2 * ( int64_t ) a * dist - ((( int64_t ) a * a ) >> 2);
+        w = ( u + a < m->vmax ) ? u + a : m->vmax;
+        if (( int64_t ) w * w + ( int64_t ) w * a > room ){
+            w = ( u < m->vmax ) ? u : m->vmax;
+            if (( int64_t ) w * w + ( int64_t ) w * a > room ){
+                w = ( u > a ) ? u - a : 0;
+            }
+        }
+    }
+    v = w * dir;
+    m->tpos += v;
+    m->vel = v;
+
+    // S-curve : moving average of the trapezoid velocity
+    if ( m->hlen > 1 ){
+        m->hsum += v - m->hist [ m->hidx ];
+        m->hist [ m->hidx ] = v;
+        if ( ++ m->hidx >= m->hlen ){
+            m->hidx = 0;
+        }
+        // hinv is rounded and so is the product: what is not output this
+        // frame is carried to the next one, so the output adds up to the
+        // trapezoid exactly instead of drifting away over a long move. The
+        // product is rounded towards zero, the output lags and never passes
+        avg = ( int64_t ) m->hsum + m->hrem;
+        v = ( int32_t )(( avg < 0) ? -(( - avg * m->hinv ) >> 16) : (( avg * m->hinv ) >> 16));
+        if ( v - m->ovel > a ){
+            v = m->ovel + a;
+        } else if ( v - m->ovel < -a ){
+            v = m->ovel - a;
+        }
+        m->hrem = ( int32_t )( avg - ( int64_t ) v * m->hlen );
+    }
+    m->pos += v;
+    m->ovel = v;
+
+    // Done once the trapezoid has stopped on the target and the average has
+    // seen hlen frames of it
+    if (( m->tpos != target ) || ( m->vel != 0 )){
+        m->settle = m->hlen;
+    } else if ( m->settle <= 1 ){
+        return _motionArrive ( m, target );
+    } else {
+        m->settle--;
+    }
+    return motionGetPosition ( m );
+}
+
+RAMFUNC int32_t motionGetPosition ( const motion_t *m ) {
+    return ( m->pos + MOTION_ONE / 2 ) >> MOTION_SHIFT;
+}
+
+RAMFUNC int motionIsDone ( const motion_t *m ) {
+    return m->done;
+}
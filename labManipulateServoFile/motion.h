@@ -0,0 +1,127 @@
+/**
+* @file motion.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Fixed-point motion planner for servo moves
+*
+* Main characteristics of this module :
+* - Unit agnostic: positions are integers in any unit (0.01 degree for
+* servo.c, SERVO_POS_SCALE )
+* - Trapezoidal profile ( velocity and acceleration limits ) or S-curve
+* profile when a jerk limit is given. The S-curve is the trapezoid through a
+* moving average of amax / jmax frames ( at most MOTION_SMOOTH_MAX ), which
+* ramps the acceleration at jmax and ends exactly on the target
+* - One motionStep () per frame gives the next position, integer arithmetic
+* only, no division: a few hundred cycles at most
+* - The planner is online: the target can change in the middle of a move,
+* the velocity is kept and the profile bends towards the new target
+* - Completion is reported by a flag and by an optional function called from
+* the frame that reaches the target
+*
+* Internally positions and velocities are Q16.16, so the position range is
+* +-32767 units.
+*
+*/
+#ifndef MOTION_H
+#define MOTION_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define MOTION_FRAME_HZ 50 /**< Calls to motionStep () per second (20 ms frame ) */
+#define MOTION_SHIFT 16 /**< Fractional bits of the internal position */
+#define MOTION_SMOOTH_MAX 32 /**< Max frames of the S-curve ramp ( amax / jmax ) */
+/* SECTION 3: Public types */
+
+struct motion_s;
+
+/**
+* @brief Function called when a move reaches its target
+*/
+
+typedef void (* motion_done_t )( struct motion_s *m, void *ctx );
+
+/**
+* @brief State of one axis. Fields are private to motion.c
+*/
+
+typedef struct motion_s {
+    int32_t pos ; /**< Output position, Q16 */
+    int32_t tpos ; /**< Position of the trapezoidal profile, Q16 */
+    int32_t vel ; /**< Velocity of the trapezoidal profile, Q16 units per frame */
+    volatile int32_t target ; /**< Target position, Q16 */
+    int32_t vmax ; /**< Velocity limit, Q16 units per frame */
+    int32_t amax ; /**< Acceleration limit, Q16 units per frame ^2 */
+    int32_t hist [ MOTION_SMOOTH_MAX ]; /**< Last velocities of the trapezoid ( S-curve ) */
+    int32_t hsum ; /**< Sum of hist [0 .. hlen ) */
+    int32_t hrem ; /**< Part of the sums not output yet, hlen times Q16 */
+    int32_t ovel ; /**< Output velocity of the last frame, Q16 units per frame */
+    uint32_t hinv ; /**< 65536 / hlen */
+    uint8_t hlen ; /**< Frames of the moving average, 1 for trapezoidal */
+    uint8_t hidx ; /**< Oldest entry of hist */
+    uint8_t settle ; /**< Frames left for the average to reach the target */
+    volatile uint8_t done ; /**< Flag (0/1), target reached and stopped */
+    motion_done_t done_fn ; /**< Called when a move completes , may be 0 */
+    void * done_ctx ; /**< Argument of done_fn */
+} motion_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize an axis stopped at a position
+* @param [in] pos Initial position ( units )
+*/
+
+void motionInit ( motion_t *m, int32_t pos );
+
+/**
+* @brief Set the limits of the moves
+* @param [in] vmax Max velocity ( units / s )
+* @param [in] amax Max acceleration ( units / s^2)
+* @param [in] jmax Max jerk ( units / s^3), 0 for a trapezoidal profile
+* Divisions happen here, in the foreground, never in motionStep ()
+*/
+
+void motionSetLimits ( motion_t *m, uint32_t vmax, uint32_t amax, uint32_t jmax );
+
+/**
+* @brief Set the function called when a move completes ( frame context )
+*/
+
+void motionOnDone ( motion_t *m, motion_done_t fn, void *ctx );
+
+/**
+* @brief Start a move, or retarget the current one
+* @param [in] target New target position ( units )
+*/
+
+void motionMoveTo ( motion_t *m, int32_t target );
+
+/**
+* @brief Stop at a position at once , without a profile
+*/
+
+void motionJump ( motion_t *m, int32_t pos );
+
+/**
+* @brief Advance one frame
+* @return New position ( units, rounded )
+*/
+
+int32_t motionStep ( motion_t *m );
+
+/**
+* @brief Position of the last frame ( units, rounded )
+*/
+
+int32_t motionGetPosition ( const motion_t *m );
+
+/**
+* @brief Flag (0/1), the last move has completed
+*/
+
+int motionIsDone ( const motion_t *m );
+
+#endif // MOTION_H
@@ -0,0 +1,371 @@
+/**
+* @file mservo.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Multi-servo (0 to 180 degrees) management, up to 8 channels on one timer
+*
+* Main characteristics of this module :
+* - Channel pins are listed in mservoPinRef, one entry per channel
+* - Timer_A1 clock is SMCLK divided as in servo.c ( servoClockCompute ), up
+* mode with a 20 ms period. Counts follow the live SMCLK ( mservoUpdateClock )
+* - Channel k raises its pulse at MSERVO_GUARD_US + k * MSERVO_STAGGER_US, so at
+* most a few pulses overlap and the supply does not see all of them at once
+* - Every rising and falling edge of the frame is an entry of a schedule
+* sorted by time. When a position has changed the schedule is rebuilt once
+* per frame, by the frame ISR at the start of the frame, into the buffer not
+* in use. The edge ISR hands it over after the last edge of the frame, when
+* the pins are idle ( double buffer with a pending flag )
+* - The frame ISR runs at a low priority ( prio.h ): the application callback
+* and the O(n^2) rebuild never delay an edge, the edge ISR preempts them
+* - Positions in 0.01 degrees and per channel calibration , as in servo.c
+* - CCR1 interrupts once per edge: the ISR writes the pin and programs the
+* next edge. Edges closer than MSERVO_EDGE_MIN_US are applied in the same ISR,
+* waiting for the counter to reach each one, so no edge is ever late
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "common.h"
+#include "mservo.h"
+#include "servo.h"
+#include "ramfunc.h"
+#include "critical.h"
+
+/* SECTION 2: Private macros */
+#define MSERVO_TIMER TIMER_A1 /**< Timer counting the frame */
+#define MSERVO_TIMER_CCR 1 /**< Compare channel used for the edges */
+#define MSERVO_GUARD_US 50 /**< Time from the frame start to the first edge */
+#define MSERVO_STAGGER_US 500 /**< Time between the rising edges of two channels */
+#define MSERVO_EDGE_MIN_US 13 /**< Edges closer than this are applied in the same ISR */
+#define MSERVO_ANG_MED (90 * SERVO_POS_SCALE ) /**< Absolute central angle (0.01 degrees ) */
+#define MSERVO_ANG_MAX SERVO_POS_MAX /**< Absolute max angle (0.01 degrees ) */
+#define MSERVO_NUM (sizeof ( mservoPinRef ) / sizeof ( output_ref_t )) /**< Channels in use */
+#define MSERVO_NUM_EDGES (2 * MSERVO_MAX_CHANNELS) /**< Schedule entries */
+
+/* SECTION 3: Private types */
+/**
+* @brief One edge of the frame
+*/
+
+typedef struct {
+    uint16_t time ; /**< Counter value of the edge */
+    uint8_t ch ; /**< Channel index in mservoPinRef */
+    uint8_t level ; /**< 1 rising edge , 0 falling edge */
+} mservo_edge_t ;
+
+/**
+* @brief Edges of a whole frame , sorted by time
+*/
+
+typedef struct {
+    mservo_edge_t edge [ MSERVO_NUM_EDGES ];
+    uint8_t num ; /**< Edges in use */
+} mservo_sched_t ;
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+/**
+* @brief Channel pins, at most MSERVO_MAX_CHANNELS entries
+*/
+
+static const output_ref_t mservoPinRef [] = {
+    {.even = P4, .port_is_odd = 0, .mask = BIT0}, /* Channel 0 on P4 .0 */
+    {.even = P4, .port_is_odd = 0, .mask = BIT1}, /* Channel 1 on P4 .1 */
+    {.even = P4, .port_is_odd = 0, .mask = BIT2}, /* Channel 2 on P4 .2 */
+    {.even = P4, .port_is_odd = 0, .mask = BIT3}, /* Channel 3 on P4 .3 */
+};
+
+static uint32_t _mservoPos [ MSERVO_MAX_CHANNELS ]; /**< Last position set per channel (0.01 degrees ) */
+static servo_cal_t _mservoCal [ MSERVO_MAX_CHANNELS ]; /**< Calibration per channel */
+static servo_conv_t _mservoConv [ MSERVO_MAX_CHANNELS ]; /**< _mservoCal converted to counts */
+static servo_clock_t _mservoClock ; /**< Timer clock setup */
+static uint16_t _mservoGuard ; /**< MSERVO_GUARD_US in counts */
+static uint16_t _mservoStagger ; /**< MSERVO_STAGGER_US in counts */
+static uint16_t _mservoEdgeMin ; /**< MSERVO_EDGE_MIN_US in counts */
+static mservo_sched_t _mservoSched [2]; /**< Schedule in use and schedule being built */
+static volatile uint8_t _mservoActive ; /**< Index of the schedule used by the ISR */
+static volatile uint8_t _mservoPending ; /**< Flag (0/1), the other schedule is ready */
+static uint8_t _mservoNext ; /**< Next edge of the active schedule ( ISR only ) */
+static volatile uint8_t _mservoDirty ; /**< Flag (0/1), a position or calibration has changed */
+static volatile uint8_t _mservoStop ; /**< Flag (0/1), disarm the edges after the last one */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Timer ISR at the start of every frame ( low priority )
+* Calls the application and rebuilds the schedule for the next frame
+*/
+
+void TA1_0_IRQHandler ( void );
+
+/**
+* @brief Timer ISR at every edge of the schedule
+* After the last edge, hands over a pending schedule and programs the first
+* edge of the next frame
+*/
+
+void TA1_N_IRQHandler ( void );
+
+/**
+* @brief Build the schedule of the current positions in the unused buffer
+* and mark it as pending. Frame ISR with no schedule pending, or edges
+* stopped
+*/
+
+static void _mservoBuild ( void );
+
+/**
+* @brief Drive a channel pin
+*/
+
+static void _mservoWrite ( uint8_t ch, uint8_t level );
+
+/**
+* @brief Derive every count from a SMCLK frequency
+*/
+
+static void _mservoSetClock ( uint32_t smclk_hz );
+
+/**
+* @brief (Re) start the timer on the schedule in _mservoActive
+*/
+
+static void _mservoTimerStart ( void );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+static void _mservoWrite ( uint8_t ch, uint8_t level ) {
+    const output_ref_t *ref = &mservoPinRef [ch];
+    if ( ref->port_is_odd ){
+        if ( level ){
+            ref->odd->OUT |= ref->mask;
+        } else {
+            ref->odd->OUT &= ~ ref->mask;
+        }
+    } else {
+        if ( level ){
+            ref->even->OUT |= ref->mask;
+        } else {
+            ref->even->OUT &= ~ ref->mask;
+        }
+    }
+}
+
+RAMFUNC static void _mservoBuild ( void ) {
+    mservo_sched_t *s;
+    mservo_edge_t e;
+    uint16_t rise;
+    uint8_t ch, i, j;
+    s = &_mservoSched [ _mservoActive ^ 1 ];
+    s->num = 0;
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        rise = _mservoGuard + ch * _mservoStagger;
+        // Insertion sort of both edges, the schedule has at most 16 entries
+        for ( j = 0; j < 2; j++ ){
+            e.ch = ch;
+            e.level = ( j == 0 );
+            e.time = ( j == 0 ) ? rise : rise + servoConvCounts (& _mservoConv [ch], _mservoPos [ch] );
+            i = s->num++;
+            while ( (i > 0) && ( s->edge [i - 1].time > e.time )){
+                s->edge [i] = s->edge [i - 1];
+                i--;
+            }
+            s->edge [i] = e;
+        }
+    }
+    _mservoPending = 1;
+}
+
+uint32_t mservoSetAbsPosition ( uint8_t ch, uint32_t pos ) {
+    if ( pos > MSERVO_ANG_MAX / SERVO_POS_SCALE ){
+        pos = MSERVO_ANG_MAX / SERVO_POS_SCALE;
+    }
+    return mservoSetAbsPositionCd ( ch, pos * SERVO_POS_SCALE ) / SERVO_POS_SCALE;
+}
+
+uint32_t mservoSetAbsPositionCd ( uint8_t ch, uint32_t pos ) {
+    if ( ch >= MSERVO_NUM ){
+        return 0;
+    }
+    // Check input argument , applying saturation if needed
+    if ( pos > MSERVO_ANG_MAX ){
+        pos = MSERVO_ANG_MAX;
+    }
+    // Only a change of position costs a new schedule, at the end of the frame
+    if ( pos != _mservoPos [ch] ){
+        _mservoPos [ch] = pos;
+        _mservoDirty = 1;
+    }
+    return pos;
+}
+
+uint32_t mservoGetPosition ( uint8_t ch ) {
+    return ( mservoGetPositionCd ( ch ) + SERVO_POS_SCALE / 2) / SERVO_POS_SCALE;
+}
+
+uint32_t mservoGetPositionCd ( uint8_t ch ) {
+    return ( ch < MSERVO_NUM ) ? _mservoPos [ch] : 0;
+}
+
+void mservoSetCalibration ( uint8_t ch, const servo_cal_t *cal ) {
+    servo_conv_t conv;
+    critical_t s;
+    if ( ch < MSERVO_NUM ){
+        servoConvInit (& conv, cal, _mservoClock.hz );
+        // The frame ISR reads the conversions when it rebuilds the schedule ,
+        // the edges keep running
+        s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_MSERVO_FRAME ));
+        _mservoCal [ch] = *cal;
+        _mservoConv [ch] = conv;
+        _mservoDirty = 1;
+        criticalExitLevel (s);
+    }
+}
+
+int mservoGetNum ( void ) {
+    return MSERVO_NUM;
+}
+
+void mservoInit ( void ) {
+    const servo_cal_t cal = SERVO_CAL_DEFAULT ;
+    uint8_t ch;
+    // Channel pins as GPIO outputs at 0
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        const output_ref_t *ref = &mservoPinRef [ch];
+        if ( ref->port_is_odd ){
+            ref->odd->SEL0 &= ~ ref->mask;
+            ref->odd->SEL1 &= ~ ref->mask;
+            ref->odd->OUT &= ~ ref->mask;
+            ref->odd->DIR |= ref->mask;
+        } else {
+            ref->even->SEL0 &= ~ ref->mask;
+            ref->even->SEL1 &= ~ ref->mask;
+            ref->even->OUT &= ~ ref->mask;
+            ref->even->DIR |= ref->mask;
+        }
+        _mservoPos [ch] = MSERVO_ANG_MED;
+        _mservoCal [ch] = cal;
+    }
+    _mservoSetClock ( CS_getSMCLK ());
+    // Central position , taken at once by the timer start
+    _mservoDirty = 0;
+    _mservoStop = 0;
+    _mservoActive = 0;
+    _mservoBuild ();
+    _mservoActive ^= 1;
+    _mservoPending = 0;
+    _mservoTimerStart ();
+    Interrupt_enableInterrupt ( INT_TA1_0 );
+    Interrupt_enableInterrupt ( INT_TA1_N );
+}
+
+void mservoUpdateClock ( void ) {
+    critical_t s;
+    uint16_t r, prev = 0;
+    uint8_t wraps = 0;
+    // Let the edges of the frame in progress finish: the edge ISR disarms
+    // CCR1 after the last one, with every pin low. Given up after two
+    // frames ( timer stopped, edge ISR masked by the caller )
+    _mservoStop = 1;
+    while (( MSERVO_TIMER -> CCTL [ MSERVO_TIMER_CCR ] & TIMER_A_CCTLN_CCIE )
+        && ( MSERVO_TIMER -> CTL & TIMER_A_CTL_MC_MASK ) && ( wraps < 2 )){
+        r = MSERVO_TIMER -> R ;
+        if ( r < prev ){
+            wraps++;
+        }
+        prev = r;
+    }
+    // No frame ISR while the counts and the schedules change
+    s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_MSERVO_FRAME ));
+    _mservoSetClock ( CS_getSMCLK ());
+    _mservoDirty = 0;
+    _mservoStop = 0;
+    _mservoBuild ();
+    _mservoActive ^= 1;
+    _mservoPending = 0;
+    _mservoTimerStart ();
+    criticalExitLevel (s);
+}
+
+static void _mservoSetClock ( uint32_t smclk_hz ) {
+    uint8_t ch;
+    servoClockCompute ( smclk_hz, & _mservoClock );
+    _mservoGuard = ( uint16_t )(( uint64_t ) MSERVO_GUARD_US * _mservoClock.hz / 1000000);
+    _mservoStagger = ( uint16_t )(( uint64_t ) MSERVO_STAGGER_US * _mservoClock.hz / 1000000);
+    _mservoEdgeMin = ( uint16_t )(( uint64_t ) MSERVO_EDGE_MIN_US * _mservoClock.hz / 1000000);
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        servoConvInit (& _mservoConv [ch], & _mservoCal [ch], _mservoClock.hz );
+    }
+}
+
+static void _mservoTimerStart ( void ) {
+    _mservoNext = 0;
+    // 1.- Stop and clear the timer , SMCLK with the divider of the clock setup
+    // ( a new ID / IDEX only takes effect after TACLR )
+    MSERVO_TIMER -> CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__STOP | _mservoClock.ctl_id ;
+    MSERVO_TIMER -> EX0 = _mservoClock.ex0 ;
+    MSERVO_TIMER -> CTL |= TIMER_A_CTL_CLR ;
+    // 2.- Frame period in CCR0 , first edge in CCR1
+    MSERVO_TIMER -> CCR [0] = _mservoClock.period - 1;
+    MSERVO_TIMER -> CCR [ MSERVO_TIMER_CCR ] = _mservoSched [ _mservoActive ].edge [0].time ;
+    MSERVO_TIMER -> CCTL [ MSERVO_TIMER_CCR ] = TIMER_A_CCTLN_CCIE ;
+    MSERVO_TIMER -> CCTL [0] = TIMER_A_CCTLN_CCIE ;
+    // 3.- Start counting in up mode
+    MSERVO_TIMER -> CTL |= TIMER_A_CTL_MC__UP ;
+}
+
+RAMFUNC void TA1_0_IRQHandler ( void ) {
+    MSERVO_TIMER -> CCTL [0] &= ~ TIMER_A_CCTLN_CCIFG ;
+    mservoFrameCallback ();
+    // A schedule still pending has not been taken by the edge ISR yet, it
+    // must not be overwritten: the change waits for the next frame
+    if ( _mservoDirty && ! _mservoPending ){
+        _mservoDirty = 0;
+        _mservoBuild ();
+    }
+}
+
+RAMFUNC void TA1_N_IRQHandler ( void ) {
+    const mservo_sched_t *s = &_mservoSched [ _mservoActive ];
+    const mservo_edge_t *e;
+    MSERVO_TIMER -> CCTL [ MSERVO_TIMER_CCR ] &= ~ TIMER_A_CCTLN_CCIFG ;
+    while (1) {
+        e = &s->edge [ _mservoNext++ ];
+        // Nearby edges are handled here: wait for the counter to get there
+        while ( MSERVO_TIMER -> R < e->time );
+        _mservoWrite ( e->ch, e->level );
+        if ( _mservoNext >= s->num ){
+            // Last edge of the frame , every pin is low: switch to the
+            // schedule built by the frame ISR, if any, and program the first
+            // edge of the next frame ( the counter rolls over before it )
+            _mservoNext = 0;
+            if ( _mservoStop ){
+                MSERVO_TIMER -> CCTL [ MSERVO_TIMER_CCR ] = 0;
+                return;
+            }
+            if ( _mservoPending ){
+                _mservoActive ^= 1;
+                _mservoPending = 0;
+            }
+            MSERVO_TIMER -> CCR [ MSERVO_TIMER_CCR ] = _mservoSched [ _mservoActive ].edge [0].time ;
+            return;
+        }
+        if ( s->edge [ _mservoNext ].time - MSERVO_TIMER -> R >= _mservoEdgeMin ){
+            MSERVO_TIMER -> CCR [ MSERVO_TIMER_CCR ] = s->edge [ _mservoNext ].time ;
+            return;
+        }
+    }
+}
+
+__attribute__((weak)) void mservoFrameCallback ( void ) {
+}
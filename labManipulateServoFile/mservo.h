@@ -0,0 +1,97 @@
+/**
+* @file mservo.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Multi-servo (0 to 180 degrees) management, up to 8 channels on one timer
+*
+* Main characteristics of this module :
+* - Channels are plain GPIO outputs listed in mservoPinRef ( mservo.c )
+* - Timer_A1 clocked from SMCLK ( divided to fit 16 bits ) counts the 20 ms frame
+* - Channel k raises its pulse 50 us + k * 0.5 ms after the frame start
+* ( MSERVO_GUARD_US, MSERVO_STAGGER_US in mservo.c ), so the pulses are
+* staggered and overlap, and the edges of two channels may fall together
+* - The edges of the frame are kept in a schedule sorted by time, rebuilt only
+* when a position changes ( once per frame, by the frame ISR at a low
+* priority ) and swapped in after the last edge of a frame.
+* The compare ISR just applies the next edge and programs the one after: O(1)
+*
+*/
+#ifndef MSERVO_H
+#define MSERVO_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+#include "servo.h"
+/* SECTION 2: Public macros */
+#define MSERVO_MAX_CHANNELS 8 /**< Channels a single timer can multiplex */
+/* SECTION 3: Public types */
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize the multi-servo module
+* Configures the channel pins as GPIO outputs at 0, moves every channel to
+* the central position (90) and starts Timer_A1
+*/
+
+void mservoInit ( void );
+
+/**
+* @brief Rescale the timing to the current SMCLK, after every clock change
+* Waits for the last edge of a frame, up to one frame and a few ms ( two
+* frames at most if the edges never stop )
+*/
+
+void mservoUpdateClock ( void );
+
+/**
+* @brief Set a new absolute position of a channel
+* @param [in] ch Channel number [0, mservoGetNum ())
+* @param [in] pos New absolute angle ( between 0 and 180), saturated
+* @return New angle of the channel
+* The new pulse is used from the frame after the current one
+*/
+
+uint32_t mservoSetAbsPosition ( uint8_t ch, uint32_t pos );
+
+/**
+* @brief mservoSetAbsPosition () in 0.01 degrees ( between 0 and SERVO_POS_MAX )
+*/
+
+uint32_t mservoSetAbsPositionCd ( uint8_t ch, uint32_t pos );
+
+/**
+* @brief Get the last position set on a channel
+*/
+
+uint32_t mservoGetPosition ( uint8_t ch );
+
+/**
+* @brief Get the last position set on a channel (0.01 degrees )
+*/
+
+uint32_t mservoGetPositionCd ( uint8_t ch );
+
+/**
+* @brief Set the calibration of a channel , SERVO_CAL_DEFAULT after mservoInit ()
+*/
+
+void mservoSetCalibration ( uint8_t ch, const servo_cal_t *cal );
+
+/**
+* @brief Number of channels managed by the module
+*/
+
+int mservoGetNum ( void );
+
+/**
+* @brief Callback executed from the frame ISR ( PRIO_MSERVO_FRAME ) at the
+* start of every frame. Positions set here are used from the next frame
+* @remarks Empty weak implementation in mservo.c
+*/
+
+extern void mservoFrameCallback ( void );
+
+#endif // MSERVO_H
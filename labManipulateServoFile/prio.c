@@ -0,0 +1,68 @@
+/**
+* @file prio.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Interrupt priority map of the drivers
+*
+* BASEPRI masks every interrupt whose priority value is equal or higher ( less
+* urgent ) and 0 masks nothing, which is why level 0 cannot be masked this
+* way: PRIMASK is the tool for that. Both are used through critical.h.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "prio.h"
+
+/* SECTION 2: Private macros */
+#define PRIO_NUM_MAP (sizeof ( _prioMap ) / sizeof ( prio_entry_t )) /**< Interrupts in the map */
+
+/* SECTION 3: Private types */
+/**
+* @brief Priority of one interrupt
+*/
+
+typedef struct {
+    uint32_t int_num ; /**< driverlib interrupt number */
+    uint8_t prio ; /**< PRIO () */
+} prio_entry_t ;
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+static const prio_entry_t _prioMap [] = {
+    { .int_num = INT_TA1_N , .prio = PRIO_MSERVO_EDGE },
+    { .int_num = INT_TA1_0 , .prio = PRIO_MSERVO_FRAME },
+    { .int_num = INT_TA2_N , .prio = PRIO_SMEAS },
+    { .int_num = INT_TA0_0 , .prio = PRIO_SERVO_FRAME },
+    { .int_num = FAULT_SYSTICK , .prio = PRIO_STIME },
+    { .int_num = INT_RTC_C , .prio = PRIO_IDLE },
+    { .int_num = INT_PORT1 , .prio = PRIO_BUTTONS },
+    { .int_num = INT_PORT2 , .prio = PRIO_BUTTONS },
+    { .int_num = INT_PORT3 , .prio = PRIO_BUTTONS },
+    { .int_num = INT_PORT4 , .prio = PRIO_BUTTONS },
+    { .int_num = INT_PORT5 , .prio = PRIO_BUTTONS },
+    { .int_num = INT_PORT6 , .prio = PRIO_BUTTONS },
+};
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+void prioInit ( void ) {
+    uint8_t i;
+    // Priority bits 7:6 preempt, bit 5 orders within a level. driverlib
+    // takes the number of preemption bits, not the AIRCR field
+    Interrupt_setPriorityGrouping ( PRIO_PREEMPT_BITS );
+    for ( i = 0; i < PRIO_NUM_MAP; i++ ){
+        Interrupt_setPriority ( _prioMap [i].int_num, _prioMap [i].prio );
+    }
+}
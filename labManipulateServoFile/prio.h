@@ -0,0 +1,54 @@
+/**
+* @file prio.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Interrupt priority map of the drivers
+*
+* Main characteristics of this module :
+* - The MSP432 has 3 priority bits, split by prioInit () into 2 preemption
+* bits ( 4 levels, 0 the most urgent ) and 1 subpriority bit ( order of two
+* pending interrupts of the same level, no preemption between them )
+* - Every driver interrupt gets its level here, in one place, instead of the
+* default priority 0 for all: the worst case latency of a level is set by
+* the levels above it only
+* - Level 0: mservo edges, software edges with microsecond timing
+* - Level 1: pulse capture and servo frame, deadlines of half a millisecond
+* and more
+* - Level 2: stime tick, idle wake-up and mservo frame ( application
+* callback and schedule rebuild, with a whole frame as deadline )
+* - Level 3: buttons, a bounce storm only delays itself
+* - criticalEnterLevel () ( critical.h ) masks one level and all below with
+* BASEPRI, the levels above still preempt
+*
+*/
+#ifndef PRIO_H
+#define PRIO_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define PRIO_SHIFT 6 /**< First bit of the preemption level in a priority */
+#define PRIO(level, sub) (( uint8_t )((( level ) << PRIO_SHIFT ) | (( sub ) << ( PRIO_SHIFT - 1)))) /**< NVIC priority */
+#define PRIO_LEVEL(prio) (( uint8_t )(( prio ) >> PRIO_SHIFT )) /**< Preemption level of an NVIC priority */
+#define PRIO_PREEMPT_BITS (8 - PRIO_SHIFT ) /**< Preemption bits, argument of Interrupt_setPriorityGrouping () */
+
+#define PRIO_MSERVO_EDGE PRIO (0, 0) /**< TA1_N */
+#define PRIO_MSERVO_FRAME PRIO (2, 1) /**< TA1_0 */
+#define PRIO_SMEAS PRIO (1, 0) /**< TA2_N */
+#define PRIO_SERVO_FRAME PRIO (1, 1) /**< TA0_0 */
+#define PRIO_STIME PRIO (2, 0) /**< SysTick */
+#define PRIO_IDLE PRIO (2, 1) /**< RTC_C */
+#define PRIO_BUTTONS PRIO (3, 0) /**< PORT1 to PORT6 */
+/* SECTION 3: Public types */
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Set the priority grouping and the priority of every driver
+* interrupt . First thing in main (), before the drivers enable them
+*/
+
+void prioInit ( void );
+
+#endif // PRIO_H
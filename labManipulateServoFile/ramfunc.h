@@ -0,0 +1,34 @@
+/**
+* @file ramfunc.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Run marked functions from SRAM
+*
+* Main characteristics of this module :
+* - RAMFUNC in front of a function definition puts the function in the
+* .TI.ramfunc section. msp432p401r.cmd loads that section in MAIN flash and
+* runs it at SRAM_CODE (0 x01000000 ), and the boot routine copies it there
+* through the BINIT table before main ()
+* - From SRAM the code runs with no flash wait states, on the I-Code bus of
+* the SRAM code alias: the ISRs that run every tick, edge or frame and the
+* kernels they call are the candidates
+* - Needs the TI compiler 15.9 or later, like the .TI.ramfunc rule of the
+* linker command file. With another compiler, or with RAMFUNC_DISABLE
+* defined ( before / after comparison with bench.c ), RAMFUNC is empty
+*
+*/
+#ifndef RAMFUNC_H
+#define RAMFUNC_H
+/* SECTION 1: Included header files to compile this file */
+/* SECTION 2: Public macros */
+#if ! defined ( RAMFUNC_DISABLE ) && defined ( __TI_COMPILER_VERSION__ ) && ( __TI_COMPILER_VERSION__ >= 15009000)
+#define RAMFUNC __attribute__ (( ramfunc )) /**< Copy to SRAM at boot and run from there */
+#else
+#define RAMFUNC /**< Run from flash */
+#endif
+/* SECTION 3: Public types */
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+#endif // RAMFUNC_H
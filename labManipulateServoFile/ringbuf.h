@@ -0,0 +1,264 @@
+/**
+* @file ringbuf.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Lock-free ring buffers to pass data from interrupts to the foreground
+*
+* Main characteristics of this module :
+* - Header only. A ring only manages indexes : the slots are an array of any
+* type owned by the caller, of a power of two length. Writing is done in
+* place between ringbufPutIndex () and ringbufPutDone (), reading between
+* ringbufGetIndex () and ringbufGetDone (), with no copy and no interrupt
+* masking
+* - ringbuf_t : one producer , one consumer ( e.g. one ISR to main ). Plain
+* loads and stores : the producer only writes head, the consumer only
+* writes tail, and a barrier orders the slot against the index
+* - ringbuf_mp_t : several producers ( ISRs of any priority and the
+* foreground ), one consumer. The producers claim slots with LDREX / STREX
+* on head, and a sequence number per slot tells the consumer which slots
+* are complete. A producer preempted between its two calls holds back the
+* consumer ( never the other producers ) until it resumes
+* - Indexes run free on 32 bits and are masked when used: all slots are
+* usable and a wrap needs no special case
+* - Host build ( compiler other than TI or ARM, or RINGBUF_HOST defined ):
+* the same code on C11 atomics, for threads on a PC
+*
+*/
+#ifndef RINGBUF_H
+#define RINGBUF_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+#if ! defined ( __TI_COMPILER_VERSION__ ) && ! defined ( __arm__ ) && ! defined ( RINGBUF_HOST )
+#define RINGBUF_HOST /**< Not compiled for the MSP432 : C11 atomics */
+#endif
+#ifdef RINGBUF_HOST
+#include <stdatomic.h>
+#else
+#include <ti/devices/msp432p4xx/inc/msp.h>
+#endif
+/* SECTION 2: Public macros */
+/* SECTION 3: Public types */
+
+/**
+* @brief Ring index or sequence number, also the type of the ringbuf_mp_t
+* sequence array
+*/
+
+#ifdef RINGBUF_HOST
+typedef _Atomic uint32_t ringbuf_idx_t ;
+#else
+typedef volatile uint32_t ringbuf_idx_t ;
+#endif
+
+/**
+* @brief Single producer, single consumer ring. Fields are private
+*/
+
+typedef struct {
+    ringbuf_idx_t head ; /**< Next slot to write, producer only */
+    ringbuf_idx_t tail ; /**< Next slot to read, consumer only */
+    uint32_t mask ; /**< Slots - 1 */
+} ringbuf_t ;
+
+/**
+* @brief Multiple producer, single consumer ring. Fields are private
+*/
+
+typedef struct {
+    ringbuf_idx_t head ; /**< Next slot to claim, all producers */
+    ringbuf_idx_t tail ; /**< Next slot to read, consumer only */
+    ringbuf_idx_t *seq ; /**< Per slot : index + 1 when written, index + slots when free */
+    uint32_t mask ; /**< Slots - 1 */
+} ringbuf_mp_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+#ifdef RINGBUF_HOST
+static inline uint32_t _ringbufLoad ( ringbuf_idx_t *p ) {
+    return atomic_load_explicit ( p, memory_order_relaxed );
+}
+static inline uint32_t _ringbufLoadAcquire ( ringbuf_idx_t *p ) {
+    return atomic_load_explicit ( p, memory_order_acquire );
+}
+static inline void _ringbufStoreRelease ( ringbuf_idx_t *p, uint32_t v ) {
+    atomic_store_explicit ( p, v, memory_order_release );
+}
+static inline int _ringbufClaim ( ringbuf_idx_t *p, uint32_t expect ) {
+    return atomic_compare_exchange_weak_explicit ( p, & expect, expect + 1, memory_order_relaxed, memory_order_relaxed );
+}
+#else
+static inline uint32_t _ringbufLoad ( ringbuf_idx_t *p ) {
+    return *p;
+}
+static inline uint32_t _ringbufLoadAcquire ( ringbuf_idx_t *p ) {
+    uint32_t v = *p;
+    // No slot access moves before the index read
+    __DMB ();
+    return v;
+}
+static inline void _ringbufStoreRelease ( ringbuf_idx_t *p, uint32_t v ) {
+    // The slot is complete before the index says so
+    __DMB ();
+    *p = v;
+}
+static inline int _ringbufClaim ( ringbuf_idx_t *p, uint32_t expect ) {
+    // STREX fails if anything ran in between, an interrupt included
+    if ( __LDREXW (p) != expect ){
+        __CLREX ();
+        return 0;
+    }
+    return __STREXW ( expect + 1, p ) == 0;
+}
+#endif
+
+/**
+* @brief Initialize an empty single producer ring
+* @param [in] len Slots of the caller array, a power of two
+* @return 0 if initialized , -1 if len is not a power of two
+*/
+
+static inline int ringbufInit ( ringbuf_t *rb, uint32_t len ) {
+    if (( len == 0) || ( len & ( len - 1))){
+        return -1;
+    }
+    rb->mask = len - 1;
+    _ringbufStoreRelease (& rb->head, 0);
+    _ringbufStoreRelease (& rb->tail, 0);
+    return 0;
+}
+
+/**
+* @brief Slot to write next ( producer )
+* @return Index in the caller array, -1 if the ring is full
+* The slot is handed to the consumer by ringbufPutDone ()
+*/
+
+static inline int32_t ringbufPutIndex ( ringbuf_t *rb ) {
+    uint32_t head = _ringbufLoad (& rb->head );
+    if ( head - _ringbufLoadAcquire (& rb->tail ) > rb->mask ){
+        return -1;
+    }
+    return ( int32_t )( head & rb->mask );
+}
+
+/**
+* @brief Publish the slot given by ringbufPutIndex () ( producer )
+*/
+
+static inline void ringbufPutDone ( ringbuf_t *rb ) {
+    _ringbufStoreRelease (& rb->head, _ringbufLoad (& rb->head ) + 1);
+}
+
+/**
+* @brief Oldest slot not read yet ( consumer )
+* @return Index in the caller array, -1 if the ring is empty
+* The slot is given back to the producer by ringbufGetDone ()
+*/
+
+static inline int32_t ringbufGetIndex ( ringbuf_t *rb ) {
+    uint32_t tail = _ringbufLoad (& rb->tail );
+    if ( _ringbufLoadAcquire (& rb->head ) == tail ){
+        return -1;
+    }
+    return ( int32_t )( tail & rb->mask );
+}
+
+/**
+* @brief Free the slot given by ringbufGetIndex () ( consumer )
+*/
+
+static inline void ringbufGetDone ( ringbuf_t *rb ) {
+    _ringbufStoreRelease (& rb->tail, _ringbufLoad (& rb->tail ) + 1);
+}
+
+/**
+* @brief Slots written and not read yet, exact for the consumer
+*/
+
+static inline uint32_t ringbufCount ( ringbuf_t *rb ) {
+    return _ringbufLoadAcquire (& rb->head ) - _ringbufLoad (& rb->tail );
+}
+
+/**
+* @brief Initialize an empty multiple producer ring
+* @param [in] seq Caller array, one sequence number per slot
+* @param [in] len Slots of the caller arrays, a power of two
+* @return 0 if initialized , -1 if len is not a power of two
+*/
+
+static inline int ringbufMpInit ( ringbuf_mp_t *rb, ringbuf_idx_t *seq, uint32_t len ) {
+    uint32_t i;
+    if (( len == 0) || ( len & ( len - 1))){
+        return -1;
+    }
+    rb->seq = seq;
+    rb->mask = len - 1;
+    for ( i = 0; i < len; i++ ){
+        _ringbufStoreRelease (& seq [i], i);
+    }
+    _ringbufStoreRelease (& rb->head, 0);
+    _ringbufStoreRelease (& rb->tail, 0);
+    return 0;
+}
+
+/**
+* @brief Claim a slot to write ( any producer )
+* @param [out] ticket Claim to give to ringbufMpPutDone ()
+* @return Index in the caller array, -1 if the ring is full
+*/
+
+static inline int32_t ringbufMpPutIndex ( ringbuf_mp_t *rb, uint32_t *ticket ) {
+    uint32_t head;
+    int32_t diff;
+
+    for (;;){
+        head = _ringbufLoad (& rb->head );
+        diff = ( int32_t )( _ringbufLoadAcquire (& rb->seq [ head & rb->mask ]) - head );
+        if ( diff < 0 ){
+            // Slot still holds the data of one turn earlier
+            return -1;
+        }
+        if (( diff == 0) && _ringbufClaim (& rb->head, head )){
+            *ticket = head;
+            return ( int32_t )( head & rb->mask );
+        }
+        // Another producer claimed it first, try the next one
+    }
+}
+
+/**
+* @brief Publish the slot claimed with ringbufMpPutIndex () ( same producer )
+*/
+
+static inline void ringbufMpPutDone ( ringbuf_mp_t *rb, uint32_t ticket ) {
+    _ringbufStoreRelease (& rb->seq [ ticket & rb->mask ], ticket + 1);
+}
+
+/**
+* @brief Oldest slot written and not read yet ( consumer )
+* @return Index in the caller array, -1 if the ring is empty or the oldest
+* slot is still being written
+*/
+
+static inline int32_t ringbufMpGetIndex ( ringbuf_mp_t *rb ) {
+    uint32_t tail = _ringbufLoad (& rb->tail );
+    if ( _ringbufLoadAcquire (& rb->seq [ tail & rb->mask ]) != tail + 1){
+        return -1;
+    }
+    return ( int32_t )( tail & rb->mask );
+}
+
+/**
+* @brief Free the slot given by ringbufMpGetIndex () ( consumer )
+*/
+
+static inline void ringbufMpGetDone ( ringbuf_mp_t *rb ) {
+    uint32_t tail = _ringbufLoad (& rb->tail );
+    _ringbufStoreRelease (& rb->seq [ tail & rb->mask ], tail + rb->mask + 1);
+    _ringbufStoreRelease (& rb->tail, tail + 1);
+}
+
+#endif // RINGBUF_H
@@ -6,38 +6,56 @@
 * @modified by Alexander Ghyoot, Michal kos
 * @modified date December 2021
 *
-* @brief Servo (0 to 180 ) management using the stick module
+* @brief Servo (0 to 180 ) management using a Timer_A PWM output
 *
 * Main characteristics of this module :
-* - Servo signal is connected to P1 .7 ( fixed )
-* - Timer clock frequency is 18 MHz ( fixed )
+* - Servo signal is connected to P2 .5 / TA0 .2 ( fixed )
+* - Timer clock is SMCLK, divided so that the 20 ms period fits the 16 bits
+* counter. Every count is derived from the live SMCLK ( servoUpdateClock ())
+* - The pulse is generated by the timer hardware ( output mode 7, reset / set ),
+* the CPU only writes the compare register once per period
+* - The compare values are computed where the position is set, into the
+* half of a double buffer the ISR is not reading, and published by
+* switching a one byte index: the period ISR copies one value to CCR2, it
+* can never see half an update
 * - Servo angle ( taking a Parallax 900 -00005 as example ) ranges from 0 to 180
-* - The generated PWM signal has a fixed frequency of 50 Hz (20 ms period )
+* - The generated PWM signal has a fixed frequency of 50 Hz (20 ms period ),
+* SERVO_FRAME_HZ
 * - The pulse width to get the servo 0 angle is 1 ms
 * - The pulse width to get the servo 180 angle is 2 ms
+* ( defaults, servoSetCalibration () sets the real endpoints, trim and direction )
+* - Positions are kept in 0.01 ( SERVO_POS_SCALE ), the degree functions
+* are wrappers of the *Cd ones
 * - The module offers the possibility to move the servo to an absolute position
 * as well as to move the servo some degress relative to its current position
+* - servoMoveAbsPosition () moves with a velocity / acceleration ( / jerk )
+* limited profile instead of jumping, one motion.c step per PWM period
+* - servoGetTrajectory () gives a waypoint queue ( traj.c ) played back one
+* step per PWM period, which takes precedence over the other moves
 *
 */
 
 /* SECTION 1: Included header files to compile this file */
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
-#include "stick.h"
 #include "servo.h"
+#include "motion.h"
+#include "traj.h"
+#include "ramfunc.h"
+#include "critical.h"
 
 /* SECTION 2: Private macros */
-#define SERVO_PWM_PERIOD 360000 /**< Whole period clock cycles */
-#define SERVO_PWM_MIN_PULSE 18000 /**< Clock cycles for the 0 pulse */
-#define SERVO_PWM_1DEG_PULSE 100 /**< Clock cycles for a relative increment of 1 */
-#define SERVO_ANG_MIN 0 /**< Absolute min angle */
-#define SERVO_ANG_MED 90 /**< Absolute central angle */
-#define SERVO_ANG_MAX 180 /**< Absolute max angle */
+#define SERVO_TIMER TIMER_A0 /**< Timer generating the PWM signal */
+#define SERVO_TIMER_CCR 2 /**< Capture / compare channel of the output ( TA0 .2 ) */
+#define SERVO_PWM_MAX_HZ ( SERVO_FRAME_HZ * 65536UL ) /**< Fastest timer clock for a 16 bits period */
+#define SERVO_ANG_MIN 0 /**< Absolute min angle (0.01) */
+#define SERVO_ANG_MED (90 * SERVO_POS_SCALE ) /**< Absolute central angle (0.01) */
+#define SERVO_ANG_MAX SERVO_POS_MAX /**< Absolute max angle (0.01) */
 
 /**
-* @brief Get the number of clock cycles from an absolute angle value
+* @brief Get the closest angle in degrees of a 0.01 position
 */
 
-#define SERVO_PWM_PULSE(x) ( SERVO_PWM_MIN_PULSE + x* SERVO_PWM_1DEG_PULSE )
+#define SERVO_POS_TO_DEG(x) ((( x ) + SERVO_POS_SCALE / 2) / SERVO_POS_SCALE )
 
 /* SECTION 3: Private types */
 /**
@@ -45,13 +63,10 @@
 */
 
 typedef struct {
-    uint32_t on_time ; /**< Positive semi - period clock cycles */
-    uint32_t off_time ; /**< Negative semi - period clock cycles */
-    uint32_t new_pos ; /**< New servo absolute position */
-    uint32_t current_pos ; /**< Current servo absolute position */
-    uint32_t state ; /**< State information to genertate the PWM signal
-    0 => at the start of the positive semi - period
-    1 => at the start of the negative semi - period */
+    uint32_t pos ; /**< Servo absolute position of the last published pulse (0.01) */
+    servo_conv_t conv ; /**< Position to clock cycles, from the calibration */
+    servo_cal_t cal ; /**< Calibration , kept to rescale conv */
+    servo_clock_t clock ; /**< Timer clock setup */
 } servo_pulse_t ;
 
 /* SECTION 4: Public variables :: definitions , no extern
@@ -61,125 +76,309 @@ typedef struct {
 (no need to declare , definitions include declarations ) */
 
 static servo_pulse_t _servo ;
+static volatile uint16_t _servoCcr [2]; /**< Pulse widths ( clock cycles ), double buffer */
+static volatile uint8_t _servoCcrIdx ; /**< Half of _servoCcr for the next period */
+static motion_t _servoMotion ; /**< Profile of the move in progress */
+static traj_t _servoTraj ; /**< Waypoint trajectory */
 
 /* SECTION 6: Private functions :: declarations , static mandatory
 Rule exception ( ISRs ) :: declarations , no static */
 
 /**
-* @brief Callback executed from the timer ISR
+* @brief Timer ISR at the start of every PWM period
 *
-* In fact this isn 't a private function (it 's invoked from the stick module ).
-* But we don 't want the function to be visible (in the .H file ) as we don 't
-* want any other code except the stick module to execute it.
-* So we do our best here : " hide " the function declaration in the .C file
-* ( pretending it is private ) with the hope the rest of the application
-* don 't see it and thus forbidding others to call the function
-* ( which is impossible , as it does not use static ).
+* The counter has just rolled over and the hardware has set the output , so
+* the new compare value is always written ahead of the falling edge .
+* The write comes first, the profile step for the next period after it.
 */
 
-void stickCallback ( void );
+void TA0_0_IRQHandler ( void );
 
 /**
-* @brief Prepare the servo for a new absolute position
-* Sets the module information so that the next callback execution that
-* corresponds to the start of the PWM period the new angle will be used .
+* @brief Publish a new absolute position (0.01)
+* Computes the pulse width into the free half of the buffer and switches
+* the index, so that the start of the next PWM period uses it. Called from
+* the ISR and from foreground sections that mask it, so that there is only
+* one writer of the free half and of the index at a time .
 */
 
-static void _servoSetPos ( void );
+static void _servoPublish ( uint32_t pos );
+
+/**
+* @brief Completion of a profiled move ( PWM period ISR )
+*/
+
+static void _servoMoveDone ( motion_t *m, void *ctx );
+
+/**
+* @brief (Re) start the timer with the current clock setup and pulse width
+*/
+
+static void _servoTimerStart ( void );
 
     /* SECTION 7: Private functions :: definitions , static mandatory
     Rule exception ( ISRs ) :: definitions , no static
     Public functions :: definitions , no extern
     Function definitions ( private & public ) written in any order */
 
-static void _servoSetPos (void){
-    _servo.current_pos = _servo.new_pos;
-    _servo.on_time = SERVO_PWM_PULSE(_servo.current_pos);
-    _servo.off_time = SERVO_PWM_PERIOD - _servo.on_time;
+RAMFUNC static void _servoPublish ( uint32_t pos ) {
+    uint8_t next = _servoCcrIdx ^ 1;
+    _servo.pos = pos;
+    _servoCcr [ next ] = ( uint16_t ) servoConvCounts (& _servo.conv, pos );
+    _servoCcrIdx = next;
+}
+
+void servoConvInit ( servo_conv_t *conv, const servo_cal_t *cal, uint32_t timer_hz ) {
+    uint32_t range;
+    // The only divisions , done here so that servoConvCounts () only multiplies
+    range = ( cal->max_us > cal->min_us ) ? ( cal->max_us - cal->min_us ) : 0;
+    conv->base = ( uint32_t )((( uint64_t ) cal->min_us * timer_hz + 500000) / 1000000);
+    conv->mult = ( uint32_t )(((( uint64_t ) range * timer_hz ) << 16) / (1000000ULL * SERVO_POS_MAX ));
+    conv->trim = cal->trim;
+    conv->reversed = cal->reversed;
+}
+
+RAMFUNC uint32_t servoConvCounts ( const servo_conv_t *conv, int32_t pos ) {
+    if ( conv->reversed ){
+        pos = SERVO_POS_MAX - pos;
+    }
+    pos += conv->trim;
+    if ( pos < 0 ){
+        pos = 0;
+    }
+    if ( pos > SERVO_POS_MAX ){
+        pos = SERVO_POS_MAX;
+    }
+    return conv->base + ( uint32_t )((( uint64_t ) pos * conv->mult + 0x8000) >> 16);
+}
+
+static void _servoMoveDone ( motion_t *m, void *ctx ) {
+    ( void ) m;
+    ( void ) ctx;
+    servoMoveDoneCallback ();
 }
 
 uint32_t servoSetAbsPosition ( uint32_t pos) {
+    // Check input argument , applying saturation if needed
+    if ( pos > SERVO_ANG_MAX / SERVO_POS_SCALE ){
+        pos = SERVO_ANG_MAX / SERVO_POS_SCALE;
+    }
+    return SERVO_POS_TO_DEG ( servoSetAbsPositionCd ( pos * SERVO_POS_SCALE ));
+}
+
+uint32_t servoSetAbsPositionCd ( uint32_t pos) {
+    critical_t s;
     // Check input argument , applying saturation if needed
     if (pos > SERVO_ANG_MAX ){
         pos = SERVO_ANG_MAX;
     }
-    // Set the new angle .
-    // This will be effective used at the start of the next positive semi - period .
-    _servo.new_pos = (uint32_t) pos;
+    // A jump cancels the move in progress ( the ISR steps the profile and
+    // publishes too ). A trajectory playing keeps the servo
+    s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    if ( trajIsPlaying (& _servoTraj )){
+        pos = _servo.pos;
+    } else {
+        motionJump (& _servoMotion, pos );
+        // Set the new angle .
+        // This will be effective used at the start of the next positive semi - period .
+        _servoPublish ( pos );
+    }
+    criticalExitLevel (s);
     // Return the new angle
-    return _servo.new_pos ;
+    return pos ;
 }
 
 uint32_t servoSetRelPosition ( int32_t delta ) {
     int32_t new_pos ;
     // Calculate the new absolute angle , applying saturation if needed
-    new_pos = _servo.current_pos + delta ;
+    new_pos = _servo.pos + delta * SERVO_POS_SCALE ;
     if ( new_pos < SERVO_ANG_MIN ){
         new_pos = SERVO_ANG_MIN;
     }
     if ( new_pos > SERVO_ANG_MAX ){
         new_pos = SERVO_ANG_MAX;
     }
-    // Set the new angle .
-    // This will be effective used at the start of the next positive semi - period .
-    _servo.new_pos = ( uint32_t ) new_pos ;
-    // Return the new angle
-    return _servo.new_pos ;
+    return SERVO_POS_TO_DEG ( servoSetAbsPositionCd (( uint32_t ) new_pos ));
+}
+
+uint32_t servoGetPositionCd ( void ) {
+    return _servo.pos;
+}
+
+void servoSetCalibration ( const servo_cal_t *cal ) {
+    servo_conv_t conv;
+    critical_t s;
+    servoConvInit (& conv, cal, _servo.clock.hz );
+    // The ISR converts every period , so it must not see half a calibration
+    s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    _servo.cal = *cal;
+    _servo.conv = conv;
+    _servoPublish ( _servo.pos );
+    criticalExitLevel (s);
+}
+
+void servoClockCompute ( uint32_t src_hz, servo_clock_t *clock ) {
+    uint32_t id, idex, div, best_div = 64;
+    clock->ctl_id = TIMER_A_CTL_ID__8;
+    clock->ex0 = 7;
+    // Smallest ID x IDEX divider ( best resolution ) with a 16 bits period
+    for ( id = 0; id < 4; id++ ){
+        for ( idex = 0; idex < 8; idex++ ){
+            div = (1UL << id ) * ( idex + 1);
+            if (( div < best_div ) && ( src_hz / div <= SERVO_PWM_MAX_HZ )){
+                best_div = div;
+                clock->ctl_id = id << TIMER_A_CTL_ID_OFS ;
+                clock->ex0 = idex;
+            }
+        }
+    }
+    clock->hz = src_hz / best_div;
+    clock->period = clock->hz / SERVO_FRAME_HZ ;
+    if ( clock->period > 65536 ){
+        clock->period = 65536; // SMCLK above 209 MHz, out of spec anyway
+    }
+}
+
+void servoUpdateClock ( void ) {
+    servo_clock_t clock;
+    servo_conv_t conv;
+    critical_t s;
+    uint16_t r, prev = 0;
+    uint8_t wraps = 0;
+    servoClockCompute ( CS_getSMCLK (), & clock );
+    servoConvInit (& conv, & _servo.cal, clock.hz );
+    // Restart only once the pulse is over, so no pulse is ever cut. The next
+    // rising edge comes one whole period after the restart : that frame is
+    // longer by about one pulse width, which servos accept. The wait stays
+    // outside the section , the rest of the period leaves ample time to
+    // reach the restart. A stopped timer, or a pulse as long as the period,
+    // ends it after at most two periods
+    while (( SERVO_TIMER -> CTL & TIMER_A_CTL_MC_MASK ) && ( wraps < 2 )){
+        r = SERVO_TIMER -> R ;
+        if ( r > SERVO_TIMER -> CCR [ SERVO_TIMER_CCR ] ){
+            break;
+        }
+        if ( r < prev ){
+            wraps++;
+        }
+        prev = r;
+    }
+    s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    _servo.clock = clock;
+    _servo.conv = conv;
+    _servoPublish ( _servo.pos );
+    _servoTimerStart ();
+    criticalExitLevel (s);
+}
+
+static void _servoTimerStart ( void ) {
+    // 1.- Stop and clear the timer , SMCLK with the divider of the clock setup
+    // ( a new ID / IDEX only takes effect after TACLR )
+    SERVO_TIMER -> CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__STOP | _servo.clock.ctl_id ;
+    SERVO_TIMER -> EX0 = _servo.clock.ex0 ;
+    SERVO_TIMER -> CTL |= TIMER_A_CTL_CLR ;
+    // 2.- Period in CCR0 ( with its interrupt at every period start ) and
+    // pulse width in CCR2 ( output set at the roll over , reset at CCR2 )
+    SERVO_TIMER -> CCR [0] = _servo.clock.period - 1;
+    SERVO_TIMER -> CCR [ SERVO_TIMER_CCR ] = _servoCcr [ _servoCcrIdx ];
+    SERVO_TIMER -> CCTL [ SERVO_TIMER_CCR ] = TIMER_A_CCTLN_OUTMOD_7 ;
+    SERVO_TIMER -> CCTL [0] = TIMER_A_CCTLN_CCIE ;
+    // 3.- Start counting in up mode
+    SERVO_TIMER -> CTL |= TIMER_A_CTL_MC__UP ;
+}
+
+uint32_t servoMoveAbsPosition ( uint32_t pos ) {
+    if ( pos > SERVO_ANG_MAX / SERVO_POS_SCALE ){
+        pos = SERVO_ANG_MAX / SERVO_POS_SCALE;
+    }
+    return SERVO_POS_TO_DEG ( servoMoveAbsPositionCd ( pos * SERVO_POS_SCALE ));
+}
+
+uint32_t servoMoveAbsPositionCd ( uint32_t pos ) {
+    critical_t s;
+    if (pos > SERVO_ANG_MAX ){
+        pos = SERVO_ANG_MAX;
+    }
+    // Start or retarget the profile , the ISR takes it from the next period
+    s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    motionMoveTo (& _servoMotion, pos );
+    criticalExitLevel (s);
+    return pos;
+}
+
+void servoSetMotionLimits ( uint32_t vmax, uint32_t amax, uint32_t jmax ) {
+    critical_t s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    motionSetLimits (& _servoMotion, vmax * SERVO_POS_SCALE, amax * SERVO_POS_SCALE, jmax * SERVO_POS_SCALE );
+    criticalExitLevel (s);
+}
+
+int servoIsMoving ( void ) {
+    return ! motionIsDone (& _servoMotion );
+}
+
+traj_t * servoGetTrajectory ( void ) {
+    return & _servoTraj ;
+}
+
+void servoTrajStart ( traj_mode_t mode ) {
+    // The trajectory starts where the servo is, and a move in progress is
+    // dropped so that it does not resume after the trajectory
+    critical_t s = criticalEnterLevel ( PRIO_LEVEL ( PRIO_SERVO_FRAME ));
+    motionJump (& _servoMotion, _servo.pos );
+    trajStart (& _servoTraj, _servo.pos, mode );
+    criticalExitLevel (s);
 }
 
 uint32_t servoInit ( void ) {
-    // Configure P1.7 as GPIO output
-    P1 -> SEL1 &= ~ BIT7 ;
-    P1 -> SEL0 &= ~ BIT7 ;
-    P1 ->DIR |= BIT7 ;
-    P1 ->DS &= ~ BIT7 ;
+    // Configure P2.5 as the TA0.2 output ( primary module function )
+    P2 -> SEL1 &= ~ BIT5 ;
+    P2 -> SEL0 |= BIT5 ;
+    P2 ->DIR |= BIT5 ;
+    P2 ->DS &= ~ BIT5 ;
+    const servo_cal_t cal = SERVO_CAL_DEFAULT ;
+    // Timer setup from the current SMCLK
+    servoClockCompute ( CS_getSMCLK (), & _servo.clock );
+    _servo.cal = cal;
+    servoConvInit (& _servo.conv, & cal, _servo.clock.hz );
     // Set the central servo position
-    _servo.new_pos = SERVO_ANG_MED ;
-    _servoSetPos ();
-    // To start generating the PWM signal :
-    // 1.- Set the output signal to 1
-    P1 ->OUT |= BIT7 ;
-    // 2.- Program the positive semi - period in the timer ( enabling interrupts )
-    stickStop ();
-    stickEnableInt ();
-    stickSetPeriod (_servo.on_time);
-    stickStart ();
-    // 3.- Update state so the next callback execution the code moves
-    // to the start of the negative semi - period
-    _servo.state = 1;
+    _servoCcrIdx = 0;
+    _servoPublish ( SERVO_ANG_MED );
+    motionInit (& _servoMotion, SERVO_ANG_MED );
+    motionOnDone (& _servoMotion, _servoMoveDone, 0);
+    // motion.c defaults are in position units, here 0.01 degrees
+    servoSetMotionLimits (90, 360, 0);
+    trajInit (& _servoTraj );
+    // Start generating the PWM signal
+    _servoTimerStart ();
+    Interrupt_enableInterrupt ( INT_TA0_0 );
     // Return the servo position
-    return _servo.new_pos ;
-}
-
-void stickCallback ( void ) {
-    // Check state to determine what to do
-    if ( _servo.state == 0) {
-        // 1.- Update absolute angle and calculations just in case
-        // the application has set a new_pos angle since the last time
-        // we got here .
-        // At the start of the positive semi - period
-        // 2.- Set the output signal to 1
-        P1 ->OUT |= BIT7 ;
-        // 3.- Program the positive semi - period in the timer
-        _servoSetPos();
-        stickStop ();
-        stickSetPeriod(_servo.on_time);
-        stickStart();
-        // 3.- Update state so the next callback execution the code moves
-        // to the start of the negative semi - period
-        _servo.state = 1;
-
-    } else {
-        // At the start of the negative semi - period
-        // 1.- Set the output signal to 0
-        P1 ->OUT &= ~ BIT7 ;
-        // 2.- Program the negative semi - period in the timer
-        stickStop ();
-        stickSetPeriod(_servo.off_time);
-        stickStart ();
-        // 3.- Update state so the next callback execution the code moves
-        // to the start of the positive semi - period
-        _servo.state = 0;
+    return SERVO_POS_TO_DEG ( _servo.pos );
+}
 
+RAMFUNC void TA0_0_IRQHandler ( void ) {
+    int32_t pos;
+    SERVO_TIMER -> CCTL [0] &= ~ TIMER_A_CCTLN_CCIFG ;
+    // Pulse width of this period, as published . The output is already
+    // high , it goes low at CCR2 .
+    SERVO_TIMER -> CCR [ SERVO_TIMER_CCR ] = _servoCcr [ _servoCcrIdx ];
+    // Next step of the trajectory or of the profiled move , if there is one,
+    // for the next period
+    if ( trajStep (& _servoTraj, & pos )){
+        if ( pos < SERVO_ANG_MIN ){
+            pos = SERVO_ANG_MIN; // The cubic can overshoot the end waypoints
+        }
+        if ( pos > SERVO_ANG_MAX ){
+            pos = SERVO_ANG_MAX;
+        }
+        _servoPublish (( uint32_t ) pos );
+        if (! trajIsPlaying (& _servoTraj )){
+            // Last frame, later moves start from here
+            motionJump (& _servoMotion, pos );
+        }
+    } else if (! motionIsDone (& _servoMotion )){
+        _servoPublish (( uint32_t ) motionStep (& _servoMotion ));
     }
 }
+
+__attribute__((weak)) void servoMoveDoneCallback ( void ) {
+}
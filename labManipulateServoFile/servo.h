@@ -3,11 +3,13 @@
 * @author Paco Rodriguez
 * @date Spring 2021
 *
-* @brief Servo (0 to 180 ) management using the stick module
+* @brief Servo (0 to 180 ) management using a Timer_A PWM output
 *
 * Main characteristics of this module :
-* - Servo signal is connected to P1 .7 ( fixed )
-* - Timer clock frequency is 18 MHz ( fixed )
+* - Servo signal is connected to P2 .5 / TA0 .2 ( fixed )
+* - Timer clock is SMCLK, divided to fit the period in 16 bits, follows
+* clock changes through servoUpdateClock ()
+* - The pulse is generated by Timer_A0 in hardware , no CPU time per edge
 * - Servo angle ( taking a Parallax 900 -00005 as example ) ranges from 0 to 180
 * - The generated PWM signal has a fixed frequency of 50 Hz (20 ms period )
 * - The pulse width to get the servo 0 angle is 1 ms
@@ -20,9 +22,52 @@
 #define SERVO_H
 /* SECTION 1: Included header files to compile this file */
 #include <stdint.h>
+#include "traj.h"
 /* SECTION 2: Public macros */
+#define SERVO_FRAME_HZ 50 /**< PWM periods per second (20 ms ) */
+#define SERVO_POS_SCALE 100 /**< Position units per degree (0.01 degrees ) */
+#define SERVO_POS_MAX (180 * SERVO_POS_SCALE ) /**< Max position (0.01 degrees ) */
+
+/**
+* @brief Calibration of a Parallax 900 -00005 as in the datasheet
+*/
+
+#define SERVO_CAL_DEFAULT { .min_us = 1000, .max_us = 2000, .trim = 0, .reversed = 0 }
 /* SECTION 3: Public types */
 
+/**
+* @brief Calibration of one servo unit
+*/
+
+typedef struct {
+    uint16_t min_us ; /**< Pulse width of the 0 degrees position ( microseconds ) */
+    uint16_t max_us ; /**< Pulse width of the 180 degrees position ( microseconds ) */
+    int16_t trim ; /**< Offset added to every position (0.01 degrees ) */
+    uint8_t reversed ; /**< Flag (0/1), the servo turns the other way */
+} servo_cal_t ;
+
+/**
+* @brief Position to timer counts conversion , precomputed from a servo_cal_t
+*/
+
+typedef struct {
+    uint32_t base ; /**< Counts of the 0 degrees pulse */
+    uint32_t mult ; /**< Counts per 0.01 degrees , Q16 */
+    int32_t trim ; /**< Offset added to every position (0.01 degrees ) */
+    uint8_t reversed ; /**< Flag (0/1), the servo turns the other way */
+} servo_conv_t ;
+
+/**
+* @brief Timer_A clock setup for a SERVO_FRAME_HZ period in 16 bits
+*/
+
+typedef struct {
+    uint32_t hz ; /**< Timer clock after the dividers */
+    uint32_t period ; /**< Timer counts per PWM period */
+    uint16_t ctl_id ; /**< ID field of TAxCTL , already shifted */
+    uint16_t ex0 ; /**< IDEX field of TAxEX0 */
+} servo_clock_t ;
+
 /* SECTION 4: Public variables :: declarations , extern mandatory */
 /* SECTION 5: Public functions :: declarations , extern optional
 Rule exception ( callbacks ) :: declarations , extern recommended */
@@ -32,7 +77,8 @@ Rule exception ( callbacks ) :: declarations , extern recommended */
 * @param [in] pos New absolute angle ( between 0 y 180)
 * If the new angle is not in the valid range [0, 180] moves the servo
 * to the closest valid position
-* @return New servo angle
+* Cancels a profiled move in progress . No effect while a trajectory plays
+* @return New servo angle , the current one if a trajectory plays
 */
 
 uint32_t servoSetAbsPosition ( uint32_t pos);
@@ -42,15 +88,126 @@ uint32_t servoSetAbsPosition ( uint32_t pos);
 * @param [in] delta Angular relative increment / decrement [ -180 , +180]
 * with respect the current servo position .
 * If the resulting angle is not in the valid range [0, 180] moves the servo
-* to the closest valid position
-* @return New servo angle
+* to the closest valid position . No effect while a trajectory plays
+* @return New servo angle , the current one if a trajectory plays
 */
 
 uint32_t servoSetRelPosition ( int32_t delta );
 
+/**
+* @brief Move the servo to an absolute position with a limited profile
+* @param [in] pos Target angle ( between 0 and 180), saturated
+* Starts a move, or retargets the one in progress keeping its velocity .
+* The profile uses the limits of servoSetMotionLimits ()
+* @return Target angle
+*/
+
+uint32_t servoMoveAbsPosition ( uint32_t pos );
+
+/**
+* @brief Set the limits of servoMoveAbsPosition ()
+* @param [in] vmax Max velocity ( degrees / s )
+* @param [in] amax Max acceleration ( degrees / s^2)
+* @param [in] jmax Max jerk ( degrees / s^3), 0 for a trapezoidal profile
+* servoInit () sets 90 degrees / s, 360 degrees / s^2 and no jerk limit
+*/
+
+void servoSetMotionLimits ( uint32_t vmax, uint32_t amax, uint32_t jmax );
+
+/**
+* @brief Flag (0/1), a profiled move is in progress
+*/
+
+int servoIsMoving ( void );
+
+/**
+* @brief Callback executed from the timer ISR when a profiled move ends
+* @remarks Empty weak implementation in servo.c
+*/
+
+extern void servoMoveDoneCallback ( void );
+
+/**
+* @brief Waypoint trajectory of the servo (0.01 degrees )
+* Push waypoints with trajPush (), the end with trajEnd (), read the
+* statistics with trajGetStats (). Any task can be the producer
+*/
+
+traj_t * servoGetTrajectory ( void );
+
+/**
+* @brief Start playing the trajectory from the current servo position
+* @param [in] mode Interpolation between waypoints
+* Cancels a profiled move in progress . While the trajectory plays
+* servoSetAbsPosition () and servoSetRelPosition () return the current
+* position without moving, and a servoMoveAbsPosition () move is dropped
+* when the trajectory ends
+*/
+
+void servoTrajStart ( traj_mode_t mode );
+
+/**
+* @brief Set a new servo absolute position in 0.01 degrees
+* @param [in] pos New absolute position ( between 0 and SERVO_POS_MAX ), saturated
+* @return New servo position (0.01 degrees ), the current one if a trajectory plays
+*/
+
+uint32_t servoSetAbsPositionCd ( uint32_t pos );
+
+/**
+* @brief servoMoveAbsPosition () in 0.01 degrees
+*/
+
+uint32_t servoMoveAbsPositionCd ( uint32_t pos );
+
+/**
+* @brief Last position set (0.01 degrees )
+*/
+
+uint32_t servoGetPositionCd ( void );
+
+/**
+* @brief Set the calibration of the servo , SERVO_CAL_DEFAULT after servoInit ()
+*/
+
+void servoSetCalibration ( const servo_cal_t *cal );
+
+/**
+* @brief Prepare the conversion of positions to timer counts ( foreground )
+* @param [in] timer_hz Timer clock frequency ( servo_clock_t hz )
+*/
+
+void servoConvInit ( servo_conv_t *conv, const servo_cal_t *cal, uint32_t timer_hz );
+
+/**
+* @brief Pick the timer dividers for a clock source
+* @param [in] src_hz Frequency of the timer source ( SMCLK )
+* The smallest ID x IDEX divider that fits the period in 16 bits is used,
+* which keeps the best pulse resolution
+*/
+
+void servoClockCompute ( uint32_t src_hz, servo_clock_t *clock );
+
+/**
+* @brief Rescale the servo timing to the current SMCLK
+* To be called after every clock change. The pulse widths are kept, the
+* period in progress ends early
+*/
+
+void servoUpdateClock ( void );
+
+/**
+* @brief Timer counts of the pulse for a position (0.01 degrees )
+* Trim and direction applied , saturated to the calibrated pulse range .
+* A multiplication , no division : safe for the PWM frame path
+*/
+
+uint32_t servoConvCounts ( const servo_conv_t *conv, int32_t pos );
+
 /**
 * Initialize the servo module
-* Configures pin P1 .7 as a GPIO output with an initial value 0 and
+* Configures pin P2 .5 as the TA0 .2 output , starts Timer_A0 ( timing derived
+* from the current SMCLK ) and
 * moves the servo to the central position (90 )
 * @return New servo angle (90 )
 */
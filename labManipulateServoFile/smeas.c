@@ -0,0 +1,223 @@
+/**
+* @file smeas.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Servo pulse measurement: width error and period jitter histograms
+*
+* Timer_A2 runs continuously on SMCLK, divided so that SMEAS_WINDOW_MS fits
+* the 16 bits counter: a width is one 16 bits difference. The 20 ms period
+* does not fit, but its jitter does: ( rise - last rise - nominal ) taken
+* modulo 2^16 is right while the jitter stays below half the window.
+*
+* The ISR reads the edge direction from CCI, the input level when it runs.
+* The pulse is at least half a millisecond long, far more than the ISR
+* latency even with the measurement load. An overwritten capture ( COV )
+* loses the pairing of the edges: it is counted and the next rising edge
+* starts over.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "smeas.h"
+#include "servo.h"
+
+/* SECTION 2: Private macros */
+#define SMEAS_TIMER TIMER_A2 /**< Timer capturing the edges */
+#define SMEAS_TIMER_CCR 1 /**< Capture channel ( TA2 .1, CCI1A on P5 .6) */
+#define SMEAS_WINDOW_MS 4 /**< Longest width the 16 bits counter must hold */
+#define SMEAS_MAX_HZ (65535UL * 1000 / SMEAS_WINDOW_MS ) /**< Fastest capture clock */
+
+/* SECTION 3: Private types */
+/**
+* @brief State of the measurement, in capture counts
+*/
+
+typedef struct {
+    uint32_t hz ; /**< Capture clock */
+    uint16_t width ; /**< Expected width */
+    uint16_t period ; /**< Nominal period, modulo 2^16 */
+    int32_t bin ; /**< Width of a bin */
+    uint16_t rise ; /**< Time of the last rising edge */
+    uint8_t have_rise ; /**< Flag (0/1), rise is valid ( period ) */
+    uint8_t in_pulse ; /**< Flag (0/1), rise starts the current pulse ( width ) */
+    volatile uint8_t running ; /**< Flag (0/1), edges are accounted */
+    smeas_stats_t stats ; /**< Extremes still in counts */
+} smeas_t ;
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+static smeas_t _smeas ;
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Add an error ( counts ) to a histogram and its extremes
+*/
+
+static void _smeasAdd ( uint32_t *hist, int32_t *min, int32_t *max, int32_t err );
+
+/**
+* @brief Capture counts to ns
+*/
+
+static int32_t _smeasNs ( int32_t counts );
+
+/**
+* @brief Timer_A2 capture ISR
+*/
+
+void TA2_N_IRQHandler ( void );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+static void _smeasAdd ( uint32_t *hist, int32_t *min, int32_t *max, int32_t err ) {
+    int32_t half = _smeas.bin / 2, i;
+    if ( err < *min ){
+        *min = err;
+    }
+    if ( err > *max ){
+        *max = err;
+    }
+    // Round to the nearest bin, both signs
+    i = (( err >= 0) ? ( err + half ) : ( err - half )) / _smeas.bin + SMEAS_BINS / 2;
+    if ( i < 0 ){
+        i = 0;
+    }
+    if ( i > SMEAS_BINS - 1 ){
+        i = SMEAS_BINS - 1;
+    }
+    hist [i]++;
+}
+
+static int32_t _smeasNs ( int32_t counts ) {
+    return ( int32_t )(( int64_t ) counts * 1000000000L / ( int64_t ) _smeas.hz );
+}
+
+void TA2_N_IRQHandler ( void ) {
+    uint16_t cctl = SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ];
+    uint16_t t = SMEAS_TIMER -> CCR [ SMEAS_TIMER_CCR ];
+    SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ] &= ~( TIMER_A_CCTLN_CCIFG | TIMER_A_CCTLN_COV );
+    if ( cctl & TIMER_A_CCTLN_COV ){
+        _smeas.stats.lost++;
+        _smeas.have_rise = 0;
+        _smeas.in_pulse = 0;
+    }
+    smeasEdge ( t, ( cctl & TIMER_A_CCTLN_CCI ) ? 1 : 0 );
+}
+
+void smeasEdge ( uint16_t t, uint8_t level ) {
+    if (! _smeas.running ){
+        return;
+    }
+    if ( level ){
+        if ( _smeas.have_rise ){
+            _smeasAdd ( _smeas.stats.period, & _smeas.stats.period_min, & _smeas.stats.period_max,
+                ( int16_t )(( uint16_t )( t - _smeas.rise ) - _smeas.period ));
+        }
+        _smeas.rise = t;
+        _smeas.have_rise = 1;
+        _smeas.in_pulse = 1;
+    } else if ( _smeas.in_pulse ){
+        _smeasAdd ( _smeas.stats.width, & _smeas.stats.width_min, & _smeas.stats.width_max,
+            ( int32_t )( uint16_t )( t - _smeas.rise ) - _smeas.width );
+        _smeas.in_pulse = 0;
+        _smeas.stats.pulses++;
+    }
+}
+
+void smeasInit ( void ) {
+    uint32_t smclk = CS_getSMCLK ();
+    uint16_t id = 0;
+
+    _smeas.running = 0;
+    // Smallest divider keeping the window within 16 bits
+    while (( id < 3) && (( smclk >> id ) > SMEAS_MAX_HZ )){
+        id++;
+    }
+    _smeas.hz = smclk >> id;
+
+    // Configure P5.6 as the TA2.1 capture input ( primary module function )
+    P5 -> SEL1 &= ~ BIT6 ;
+    P5 -> SEL0 |= BIT6 ;
+    P5 ->DIR &= ~ BIT6 ;
+
+    SMEAS_TIMER -> CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__STOP | ( id << TIMER_A_CTL_ID_OFS );
+    SMEAS_TIMER -> EX0 = TIMER_A_EX0_IDEX__1 ;
+    SMEAS_TIMER -> CTL |= TIMER_A_CTL_CLR ;
+    // Both edges, synchronised to the timer clock
+    SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ] = TIMER_A_CCTLN_CM__BOTH | TIMER_A_CCTLN_CCIS__CCIA |
+        TIMER_A_CCTLN_SCS | TIMER_A_CCTLN_CAP ;
+    SMEAS_TIMER -> CTL |= TIMER_A_CTL_MC__CONTINUOUS ;
+}
+
+void smeasStart ( uint32_t width_us ) {
+    uint8_t i;
+
+    Interrupt_disableInterrupt ( INT_TA2_N );
+    _smeas.running = 0;
+    _smeas.width = ( uint16_t )((( uint64_t ) width_us * _smeas.hz + 500000) / 1000000);
+    _smeas.period = ( uint16_t )(( _smeas.hz + SERVO_FRAME_HZ / 2) / SERVO_FRAME_HZ );
+    _smeas.bin = ( int32_t )((( uint64_t ) SMEAS_BIN_NS * _smeas.hz + 500000000) / 1000000000);
+    if ( _smeas.bin < 1 ){
+        _smeas.bin = 1;
+    }
+    for ( i = 0; i < SMEAS_BINS; i++ ){
+        _smeas.stats.width [i] = 0;
+        _smeas.stats.period [i] = 0;
+    }
+    _smeas.stats.pulses = 0;
+    _smeas.stats.lost = 0;
+    _smeas.stats.width_min = INT32_MAX;
+    _smeas.stats.width_max = INT32_MIN;
+    _smeas.stats.period_min = INT32_MAX;
+    _smeas.stats.period_max = INT32_MIN;
+    _smeas.have_rise = 0;
+    _smeas.in_pulse = 0;
+    _smeas.running = 1;
+
+    SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ] &= ~( TIMER_A_CCTLN_CCIFG | TIMER_A_CCTLN_COV );
+    SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ] |= TIMER_A_CCTLN_CCIE ;
+    Interrupt_enableInterrupt ( INT_TA2_N );
+}
+
+void smeasStop ( void ) {
+    Interrupt_disableInterrupt ( INT_TA2_N );
+    SMEAS_TIMER -> CCTL [ SMEAS_TIMER_CCR ] &= ~ TIMER_A_CCTLN_CCIE ;
+    _smeas.running = 0;
+}
+
+uint32_t smeasGetPulses ( void ) {
+    return _smeas.stats.pulses;
+}
+
+void smeasGetStats ( smeas_stats_t *stats ) {
+    Interrupt_disableInterrupt ( INT_TA2_N );
+    *stats = _smeas.stats;
+    if ( _smeas.running ){
+        Interrupt_enableInterrupt ( INT_TA2_N );
+    }
+    if ( stats->pulses == 0 ){
+        stats->width_min = 0;
+        stats->width_max = 0;
+    }
+    if ( stats->period_min > stats->period_max ){
+        stats->period_min = 0;
+        stats->period_max = 0;
+    }
+    stats->width_min = _smeasNs ( stats->width_min );
+    stats->width_max = _smeasNs ( stats->width_max );
+    stats->period_min = _smeasNs ( stats->period_min );
+    stats->period_max = _smeasNs ( stats->period_max );
+    stats->bin_ns = ( uint32_t ) _smeasNs ( _smeas.bin );
+    stats->resolution_ns = ( uint32_t ) _smeasNs (1);
+}
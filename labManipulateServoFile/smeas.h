@@ -0,0 +1,92 @@
+/**
+* @file smeas.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Servo pulse measurement: width error and period jitter histograms
+*
+* Main characteristics of this module :
+* - The servo output is wired back to P5 .6 / TA2 .1 ( fixed ), captured on
+* both edges by Timer_A2. The edge times come from the capture hardware ,
+* so the latency of the capture ISR does not show in the results
+* - Every pulse adds its width error ( measured - expected ) and the jitter
+* of its period ( rising edge to rising edge - 1 / SERVO_FRAME_HZ ) to two
+* histograms of SMEAS_BINS bins, SMEAS_BIN_NS wide, centred on 0
+* - smeasEdge () does all the work and does not touch the hardware: a host
+* build can feed it the edges of a simulated pin trace
+* - Results are read with smeasGetStats (), in ns
+*
+*/
+#ifndef SMEAS_H
+#define SMEAS_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define SMEAS_BINS 17 /**< Histogram bins, odd: the middle one is a zero error */
+#define SMEAS_BIN_NS 250 /**< Width of a bin ( ns ), rounded to capture counts */
+/* SECTION 3: Public types */
+
+/**
+* @brief Measurement results
+* Bin i holds the errors around ( i - SMEAS_BINS / 2) * bin_ns, the first and
+* the last bin also hold everything beyond them
+*/
+
+typedef struct {
+    uint32_t width [ SMEAS_BINS ]; /**< Width error histogram */
+    uint32_t period [ SMEAS_BINS ]; /**< Period jitter histogram */
+    uint32_t pulses ; /**< Pulses measured */
+    uint32_t lost ; /**< Captures overwritten before the ISR read them */
+    int32_t width_min ; /**< Smallest width error ( ns ) */
+    int32_t width_max ; /**< Largest width error ( ns ) */
+    int32_t period_min ; /**< Smallest period jitter ( ns ) */
+    int32_t period_max ; /**< Largest period jitter ( ns ) */
+    uint32_t bin_ns ; /**< Real width of a bin ( ns ) */
+    uint32_t resolution_ns ; /**< One capture count ( ns ) */
+} smeas_stats_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize the capture pin and Timer_A2, from the live SMCLK
+* The measurement is stopped
+*/
+
+void smeasInit ( void );
+
+/**
+* @brief Clear the results and start measuring
+* @param [in] width_us Expected pulse width ( us )
+*/
+
+void smeasStart ( uint32_t width_us );
+
+/**
+* @brief Stop measuring, the results are kept
+*/
+
+void smeasStop ( void );
+
+/**
+* @brief Pulses measured since smeasStart ()
+*/
+
+uint32_t smeasGetPulses ( void );
+
+/**
+* @brief Copy of the results, converted to ns
+*/
+
+void smeasGetStats ( smeas_stats_t *stats );
+
+/**
+* @brief Account one edge of the servo signal ( capture ISR )
+* @param [in] t Capture time ( counts of the smeasInit () clock, 16 bits )
+* @param [in] level Flag (0/1), 1 for a rising edge
+*/
+
+void smeasEdge ( uint16_t t, uint8_t level );
+
+#endif // SMEAS_H
@@ -9,6 +9,7 @@
 /* SECTION 1: Included header files to compile this file */
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 # include "stick.h"
+#include "ramfunc.h"
 /* SECTION 2: Private macros */
 /* SECTION 3: Private types */
 /* SECTION 4: Public variables :: definitions , no extern
@@ -42,7 +43,7 @@ Function definitions ( private & public ) written in any order */
 * It is the callback where the functionality is to be added
 */
 
-void stickISR ( void ) {
+RAMFUNC void SysTick_Handler ( void ) {
     stickClearIntFlag ();
     stickCallback ();
 }
@@ -147,11 +148,20 @@ uint32_t stickGetCount ( void ) {
     return ( SysTick ->VAL & SysTick_VAL_CURRENT_Msk );
 }
 
+/**
+* @brief Restart the current period from its beginning
+* @remarks The interrupt flag is cleared ( side effect )
+*/
+
+void stickResetCount ( void ) {
+    SysTick ->VAL = 0; // Any write clears the counter, reloaded on the next clock
+}
+
 /**
 * @brief Clear the timer interrupt flag
 */
 
-void stickClearIntFlag ( void ) {
+RAMFUNC void stickClearIntFlag ( void ) {
     SysTick -> CTRL &= ~ SysTick_CTRL_COUNTFLAG_Msk ;
 }
 
@@ -66,6 +66,11 @@ uint32_t stickGetPeriod ( void );
 */
 uint32_t stickGetCount ( void );
 /**
+* @brief Restart the current period from its beginning
+* @remarks The interrupt flag is cleared ( side effect )
+*/
+void stickResetCount ( void );
+/**
 * @brief Clear the timer interrupt flag
 */
 void stickClearIntFlag ( void );
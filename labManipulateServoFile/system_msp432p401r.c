@@ -53,6 +53,9 @@
    3. If you prefer the DC-DC power regulator (more efficient at higher
        frequencies), set the __REGULATOR to 1:
    #define __REGULATOR      1
+   4. Or pick a startup profile, which sets the three settings below together
+      (clock, regulator and flash read buffering):
+   #define __STARTUP_PROFILE   1
  *---------------------------------------------------------------------------*/
 
 /*--------------------- Watchdog Timer Configuration ------------------------*/
@@ -61,6 +64,34 @@
 //     <1> Halt the WDT
 #define __HALT_WDT         1
 
+/*--------------------- Startup Profile Configuration -----------------------*/
+//  Startup Profile
+//     <0> Custom: __SYSTEM_CLOCK, __REGULATOR and __FLASH_BUFFERING below
+//     <1> Performance: 48 MHz, DC-DC, read buffering on both banks
+//     <2> Balanced: 24 MHz, DC-DC, read buffering as set for 24 MHz (bank 0)
+//     <3> Low power: 3 MHz, LDO, no read buffering
+//  DC-DC needs the inductor on VSW (fitted on the LaunchPad). It pays off at
+//  the high currents of 24 and 48 MHz; at 3 MHz the load is light, the LDO
+//  has no switching loss and no inductor, and moves to the low power modes
+//  directly. Flash has no wait states at 3 MHz, so buffering has nothing to
+//  hide there. To see what a setting is worth, build bench.c with MAIN_BENCH
+//  per profile, with and without RAMFUNC_DISABLE (flash vs SRAM planner)
+#define __STARTUP_PROFILE  0
+
+#if (__STARTUP_PROFILE == 1)
+#define  __SYSTEM_CLOCK    48000000
+#define __REGULATOR        1
+#define __FLASH_BUFFERING  1
+#elif (__STARTUP_PROFILE == 2)
+#define  __SYSTEM_CLOCK    24000000
+#define __REGULATOR        1
+#define __FLASH_BUFFERING  0
+#elif (__STARTUP_PROFILE == 3)
+#define  __SYSTEM_CLOCK    3000000
+#define __REGULATOR        0
+#define __FLASH_BUFFERING  0
+#else
+
 /*--------------------- CPU Frequency Configuration -------------------------*/
 //  CPU Frequency
 //     <1500000> 1.5 MHz
@@ -76,6 +107,13 @@
 //     <1> DC-DC
 #define __REGULATOR        0
 
+/*--------------------- Flash Read Buffering Configuration ------------------*/
+//  Flash Read Buffering
+//     <0> As set for the CPU frequency (none up to 12 MHz, bank 0 at 24 MHz)
+//     <1> Both banks, data and instructions, whatever the CPU frequency
+#define __FLASH_BUFFERING  0
+#endif
+
 /*----------------------------------------------------------------------------
    Define clocks, used for SystemCoreClockUpdate()
  *---------------------------------------------------------------------------*/
@@ -258,6 +296,7 @@ void SystemCoreClockUpdate(void)
  *     5. Enable Flash wait states if needed
  *     6. Change MCLK to desired frequency
  *     7. Enable Flash read buffering
+ *     8. Enable it on both banks if __FLASH_BUFFERING is set
  */
 void SystemInit(void)
 {
@@ -396,6 +435,14 @@ void SystemInit(void)
     FLCTL->BANK1_RDCTL = FLCTL->BANK1_RDCTL | (FLCTL_BANK1_RDCTL_BUFD | FLCTL_BANK1_RDCTL_BUFI);
     #endif
 
+    #if __FLASH_BUFFERING
+    // Read buffering on both banks whatever the frequency: fetches hit the
+    // buffer instead of the flash array, faster with wait states and fewer
+    // flash reads without
+    FLCTL->BANK0_RDCTL = FLCTL->BANK0_RDCTL | (FLCTL_BANK0_RDCTL_BUFD | FLCTL_BANK0_RDCTL_BUFI);
+    FLCTL->BANK1_RDCTL = FLCTL->BANK1_RDCTL | (FLCTL_BANK1_RDCTL_BUFD | FLCTL_BANK1_RDCTL_BUFI);
+    #endif
+
 }
 
 
@@ -0,0 +1,179 @@
+/**
+* @file critical_check.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Host check of the critical sections and their CRITICAL_DEBUG asserts
+*
+* critical.h is built in its simulator mode ( CRITICAL_SIM ), where PRIMASK
+* and BASEPRI are variables and every exit asserts. The program checks:
+* - nested criticalEnter () / criticalEnterLevel (), mixed, from no mask and
+* from masks already set: which prio.h interrupts would run at each depth,
+* and that every exit puts back the state of its entry
+* - misuse, each one in a child process that must die on an assert: exits
+* out of order, one exit twice, an exit after the mask was cleared inside
+* the section, a level out of 1 to 3
+* Exit status 0 when every check passes.
+*
+* Build and run from labManipulateServoFile :
+* gcc -std=gnu11 -Wall -I. tools/critical_check.c critical.c
+* -o tools/critical_check.out
+* tools/critical_check.out
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <stdio.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "critical.h"
+
+/* SECTION 2: Private macros */
+#define CHECK(cond) _check (( cond ), #cond, __LINE__ ) /**< Count a failed condition */
+
+/* SECTION 5: Private variables */
+
+static uint32_t _checkErrors ;
+
+/* SECTION 7: Private functions */
+
+static void _check ( int ok, const char *what, int line ) {
+    if ( ! ok ){
+        printf ("line %d: %s\n", line, what );
+        _checkErrors++;
+    }
+}
+
+/**
+* @brief The emulated masks are back to an expected state
+*/
+
+static int _checkIdle ( uint32_t primask, uint32_t basepri ) {
+    return ( criticalSimPrimask == primask ) && ( criticalSimBasepri == basepri ) && ( criticalDepth == 0);
+}
+
+static void _checkNesting ( void ) {
+    critical_t a, b, c;
+
+    // Levels: each one masks itself and the ones below, never level 0
+    a = criticalEnterLevel (2);
+    CHECK ( criticalSimIrqAllowed ( PRIO_MSERVO_EDGE ));
+    CHECK ( criticalSimIrqAllowed ( PRIO_SERVO_FRAME ));
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_STIME ));
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_BUTTONS ));
+    // A looser level inside keeps the stricter mask
+    b = criticalEnterLevel (3);
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_STIME ));
+    // A stricter one inside narrows it
+    c = criticalEnterLevel (1);
+    CHECK ( criticalSimIrqAllowed ( PRIO_MSERVO_EDGE ));
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_SMEAS ));
+    criticalExitLevel (c);
+    CHECK ( criticalSimIrqAllowed ( PRIO_SMEAS ));
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_STIME ));
+    criticalExitLevel (b);
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_IDLE ));
+    criticalExitLevel (a);
+    CHECK ( _checkIdle (0, 0));
+    CHECK ( criticalSimIrqAllowed ( PRIO_BUTTONS ));
+
+    // Everything masked, inside and around a level section
+    a = criticalEnterLevel (3);
+    b = criticalEnter ();
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_MSERVO_EDGE ));
+    c = criticalEnter ();
+    criticalExit (c);
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_MSERVO_EDGE ));
+    criticalExit (b);
+    CHECK ( criticalSimIrqAllowed ( PRIO_MSERVO_EDGE ));
+    CHECK ( ! criticalSimIrqAllowed ( PRIO_BUTTONS ));
+    criticalExitLevel (a);
+    CHECK ( _checkIdle (0, 0));
+
+    // Entered with the masks already set ( from an ISR, or after a disable ):
+    // the exits must not clear them
+    criticalSimPrimask = 1;
+    criticalSimBasepri = PRIO (1, 0);
+    a = criticalEnter ();
+    b = criticalEnterLevel (3);
+    CHECK ( criticalSimBasepri == PRIO (1, 0));
+    criticalExitLevel (b);
+    criticalExit (a);
+    CHECK ( _checkIdle (1, PRIO (1, 0)));
+    criticalSimPrimask = 0;
+    criticalSimBasepri = 0;
+}
+
+/**
+* @brief Run a misuse in a child: it must end on an assert ( SIGABRT )
+*/
+
+static void _checkAborts ( const char *name, void (* misuse )( void )) {
+    int status;
+    pid_t pid = fork ();
+
+    if ( pid == 0){
+        // The expected assert message is not an error of this program
+        freopen ("/dev/null", "w", stderr );
+        misuse ();
+        _exit (0);
+    }
+    if (( pid < 0) || ( waitpid ( pid, & status, 0) != pid )){
+        printf ("%s: cannot run\n", name );
+        _checkErrors++;
+        return;
+    }
+    if ( ! WIFSIGNALED ( status ) || ( WTERMSIG ( status ) != SIGABRT )){
+        printf ("%s: no assert\n", name );
+        _checkErrors++;
+    }
+}
+
+static void _misuseOrder ( void ) {
+    critical_t a = criticalEnter (), b = criticalEnterLevel (2);
+    criticalExit (a);
+    criticalExitLevel (b);
+}
+
+static void _misuseOrderLevel ( void ) {
+    critical_t a = criticalEnterLevel (3), b = criticalEnterLevel (1);
+    criticalExitLevel (a);
+    criticalExitLevel (b);
+}
+
+static void _misuseTwice ( void ) {
+    critical_t a = criticalEnter (), b = criticalEnter ();
+    criticalExit (b);
+    criticalExit (b);
+    criticalExit (a);
+}
+
+static void _misuseUnmasked ( void ) {
+    critical_t a = criticalEnter ();
+    // As an __enable_irq () inside the section would
+    criticalSimPrimask = 0;
+    criticalExit (a);
+}
+
+static void _misuseUnmaskedLevel ( void ) {
+    critical_t a = criticalEnterLevel (2);
+    criticalSimBasepri = 0;
+    criticalExitLevel (a);
+}
+
+static void _misuseLevel0 ( void ) {
+    criticalExitLevel ( criticalEnterLevel (0));
+}
+
+int main ( void ) {
+    _checkNesting ();
+    _checkAborts ("exit out of order", _misuseOrder );
+    _checkAborts ("level exit out of order", _misuseOrderLevel );
+    _checkAborts ("exit twice", _misuseTwice );
+    _checkAborts ("unmasked inside", _misuseUnmasked );
+    _checkAborts ("level unmasked inside", _misuseUnmaskedLevel );
+    _checkAborts ("level 0", _misuseLevel0 );
+    printf ("%lu errors\n", ( unsigned long ) _checkErrors );
+    return _checkErrors ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+/**
+* @file host.c
+* @brief Peripherals and driverlib of the host build of the programs in tools/
+*
+* Link with every host program that compiles driver sources. The registers
+* are zero at start, like after a reset with the timers stopped.
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <assert.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* SECTION 4: Public variables :: definitions , no extern */
+
+uint8_t hostDio [0x80];
+SysTick_Type hostSysTick ;
+DWT_Type hostDwt ;
+CoreDebug_Type hostCoreDebug ;
+Timer_A_Type hostTimerA [4];
+SCB_Type hostScb ;
+PCM_Type hostPcm ;
+FLCTL_Type hostFlctl ;
+CS_Type hostCs ;
+RTC_C_Type hostRtc ;
+uint32_t SystemCoreClock = 3000000;
+uint32_t hostMclk = 3000000;
+uint32_t hostSmclk = 3000000;
+uint8_t hostIntEnabled [64];
+
+/* SECTION 7: Public functions :: definitions */
+
+void WDT_A_holdTimer ( void ) {
+}
+
+void Interrupt_enableInterrupt ( uint32_t n ) {
+    hostIntEnabled [n & 63] = 1;
+}
+
+void Interrupt_disableInterrupt ( uint32_t n ) {
+    hostIntEnabled [n & 63] = 0;
+}
+
+bool Interrupt_enableMaster ( void ) {
+    return true;
+}
+
+bool Interrupt_disableMaster ( void ) {
+    return true;
+}
+
+void Interrupt_setPriority ( uint32_t n, uint8_t prio ) {
+}
+
+uint8_t Interrupt_getPriority ( uint32_t n ) {
+    return 0;
+}
+
+void Interrupt_setPriorityGrouping ( uint32_t g ) {
+    // driverlib indexes a table of 8 AIRCR values with the preemption bits
+    assert ( g < 8);
+}
+
+void Interrupt_setPriorityMask ( uint8_t m ) {
+}
+
+uint32_t CS_getMCLK ( void ) {
+    return hostMclk;
+}
+
+uint32_t CS_getSMCLK ( void ) {
+    return hostSmclk;
+}
+
+uint32_t CS_getACLK ( void ) {
+    return 32768;
+}
+
+void CS_setDCOCenteredFrequency ( uint32_t f ) {
+}
+
+void CS_initClockSignal ( uint32_t sig, uint32_t src, uint32_t div ) {
+}
+
+void CS_setReferenceOscillatorFrequency ( uint8_t f ) {
+}
+
+bool PCM_setCoreVoltageLevel ( uint_fast8_t level ) {
+    return true;
+}
+
+uint8_t PCM_getCoreVoltageLevel ( void ) {
+    return 0;
+}
+
+bool PCM_setPowerMode ( uint_fast8_t mode ) {
+    return true;
+}
+
+bool PCM_gotoLPM0 ( void ) {
+    return true;
+}
+
+bool PCM_gotoLPM3 ( void ) {
+    return true;
+}
+
+bool FlashCtl_setWaitState ( uint32_t bank, uint32_t wait ) {
+    return true;
+}
+
+void FlashCtl_enableReadBuffering ( uint_fast8_t bank, uint_fast8_t access ) {
+}
+
+void FlashCtl_disableReadBuffering ( uint_fast8_t bank, uint_fast8_t access ) {
+}
+
+void SysCtl_enableSRAMBankRetention ( uint32_t banks ) {
+}
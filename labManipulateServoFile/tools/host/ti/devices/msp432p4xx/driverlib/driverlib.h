@@ -0,0 +1,79 @@
+/**
+* @file driverlib.h
+* @brief Host stand-in for the TI driverlib, for the programs in tools/
+*
+* The functions are in host.c: interrupt enables are recorded, the clock
+* getters return hostMclk and hostSmclk, the rest does nothing.
+*
+*/
+#ifndef HOST_DRIVERLIB_H
+#define HOST_DRIVERLIB_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "../inc/msp.h"
+#define INT_PORT1 (51)
+#define INT_PORT2 (52)
+#define INT_PORT3 (53)
+#define INT_PORT4 (54)
+#define INT_PORT5 (55)
+#define INT_PORT6 (56)
+#define FAULT_SYSTICK (15)
+#define INT_TA0_0 (24)
+#define INT_TA0_N (25)
+#define INT_TA1_0 (26)
+#define INT_TA1_N (27)
+#define INT_TA2_0 (28)
+#define INT_TA2_N (29)
+#define INT_TA3_0 (30)
+#define INT_TA3_N (31)
+#define INT_RTC_C (45)
+void WDT_A_holdTimer(void);
+void Interrupt_enableInterrupt(uint32_t);
+void Interrupt_disableInterrupt(uint32_t);
+bool Interrupt_enableMaster(void);
+bool Interrupt_disableMaster(void);
+void Interrupt_setPriority(uint32_t, uint8_t);
+uint8_t Interrupt_getPriority(uint32_t);
+void Interrupt_setPriorityGrouping(uint32_t);
+void Interrupt_setPriorityMask(uint8_t);
+uint32_t CS_getMCLK(void);
+uint32_t CS_getSMCLK(void);
+uint32_t CS_getACLK(void);
+void CS_setDCOCenteredFrequency(uint32_t);
+void CS_initClockSignal(uint32_t, uint32_t, uint32_t);
+void CS_setReferenceOscillatorFrequency(uint8_t);
+#define CS_DCO_FREQUENCY_1_5 0
+#define CS_DCO_FREQUENCY_3 1
+#define CS_DCO_FREQUENCY_6 2
+#define CS_DCO_FREQUENCY_12 3
+#define CS_DCO_FREQUENCY_24 4
+#define CS_DCO_FREQUENCY_48 5
+#define CS_MCLK 1
+#define CS_SMCLK 2
+#define CS_HSMCLK 3
+#define CS_ACLK 4
+#define CS_DCOCLK_SELECT 3
+#define CS_REFOCLK_SELECT 2
+#define CS_CLOCK_DIVIDER_1 0
+#define CS_REFO_32KHZ 0
+bool PCM_setCoreVoltageLevel(uint_fast8_t);
+uint8_t PCM_getCoreVoltageLevel(void);
+bool PCM_setPowerMode(uint_fast8_t);
+bool PCM_gotoLPM0(void);
+bool PCM_gotoLPM3(void);
+#define PCM_VCORE0 0
+#define PCM_VCORE1 1
+#define PCM_LDO_MODE 0
+#define PCM_DCDC_MODE 1
+bool FlashCtl_setWaitState(uint32_t, uint32_t);
+void FlashCtl_enableReadBuffering(uint_fast8_t, uint_fast8_t);
+void FlashCtl_disableReadBuffering(uint_fast8_t, uint_fast8_t);
+#define FLASH_BANK0 0
+#define FLASH_BANK1 1
+#define FLASH_DATA_READ_BURST 1
+#define FLASH_INSTRUCTION_FETCH 2
+void SysCtl_enableSRAMBankRetention(uint32_t);
+extern uint32_t hostMclk; /**< CS_getMCLK () */
+extern uint32_t hostSmclk; /**< CS_getSMCLK () */
+extern uint8_t hostIntEnabled [64]; /**< Interrupt_enableInterrupt () state per number */
+#endif // HOST_DRIVERLIB_H
@@ -0,0 +1,171 @@
+/**
+* @file msp.h
+* @brief Host stand-in for the TI device header, for the programs in tools/
+*
+* Only what the driver sources use. The peripherals are plain memory
+* ( host.c ), so a host program can read what a driver wrote and play the
+* hardware , e.g. move a counter or raise a flag before calling an ISR. The
+* core intrinsics do nothing : critical.h and ringbuf.h have their own host
+* versions.
+*
+*/
+#ifndef HOST_MSP_H
+#define HOST_MSP_H
+#include <stdint.h>
+#define __I volatile const
+#define __O volatile
+#define __IO volatile
+typedef struct { __I uint8_t IN; uint8_t r0; __IO uint8_t OUT; uint8_t r1; __IO uint8_t DIR; uint8_t r2; __IO uint8_t REN; uint8_t r3; __IO uint8_t DS; uint8_t r4; __IO uint8_t SEL0; uint8_t r5; __IO uint8_t SEL1; uint8_t r6; __I uint16_t IV; uint8_t r7[6]; __IO uint8_t SELC; uint8_t r8; __IO uint8_t IES; uint8_t r9; __IO uint8_t IE; uint8_t r10; __IO uint8_t IFG; uint8_t r11; } DIO_PORT_Odd_Interruptable_Type;
+typedef struct { uint8_t r0; __I uint8_t IN; uint8_t r1; __IO uint8_t OUT; uint8_t r2; __IO uint8_t DIR; uint8_t r3; __IO uint8_t REN; uint8_t r4; __IO uint8_t DS; uint8_t r5; __IO uint8_t SEL0; uint8_t r6; __IO uint8_t SEL1; uint8_t r7[0xE]; __IO uint8_t SELC; uint8_t r8; __IO uint8_t IES; uint8_t r9; __IO uint8_t IE; uint8_t r10; __IO uint8_t IFG; __I uint16_t IV; } DIO_PORT_Even_Interruptable_Type;
+extern uint8_t hostDio [0x80]; /**< P1 to P8, with the real layout */
+#define DIO_BASE (( uintptr_t ) hostDio )
+#define P1 ((DIO_PORT_Odd_Interruptable_Type*)(DIO_BASE+0x00))
+#define P2 ((DIO_PORT_Even_Interruptable_Type*)(DIO_BASE+0x00))
+#define P3 ((DIO_PORT_Odd_Interruptable_Type*)(DIO_BASE+0x20))
+#define P4 ((DIO_PORT_Even_Interruptable_Type*)(DIO_BASE+0x20))
+#define P5 ((DIO_PORT_Odd_Interruptable_Type*)(DIO_BASE+0x40))
+#define P6 ((DIO_PORT_Even_Interruptable_Type*)(DIO_BASE+0x40))
+#define P7 ((DIO_PORT_Odd_Interruptable_Type*)(DIO_BASE+0x60))
+#define P8 ((DIO_PORT_Even_Interruptable_Type*)(DIO_BASE+0x60))
+#define BIT0 (0x01) 
+#define BIT1 (0x02)
+#define BIT2 (0x04)
+#define BIT3 (0x08)
+#define BIT4 (0x10)
+#define BIT5 (0x20)
+#define BIT6 (0x40)
+#define BIT7 (0x80)
+#define BIT(x) (1u<<(x))
+typedef struct { __IO uint32_t CTRL, LOAD, VAL; __I uint32_t CALIB; } SysTick_Type;
+extern SysTick_Type hostSysTick;
+#define SysTick (& hostSysTick )
+#define SysTick_CTRL_COUNTFLAG_Pos 16
+#define SysTick_CTRL_COUNTFLAG_Msk (1ul<<16)
+#define SysTick_CTRL_CLKSOURCE_Pos 2
+#define SysTick_CTRL_CLKSOURCE_Msk (1ul<<2)
+#define SysTick_CTRL_TICKINT_Pos 1
+#define SysTick_CTRL_TICKINT_Msk (1ul<<1)
+#define SysTick_CTRL_ENABLE_Pos 0
+#define SysTick_CTRL_ENABLE_Msk (1ul)
+#define SysTick_LOAD_RELOAD_Msk (0xFFFFFFul)
+#define SysTick_VAL_CURRENT_Msk (0xFFFFFFul)
+typedef struct { __IO uint32_t CTRL; __IO uint32_t CYCCNT; } DWT_Type;
+extern DWT_Type hostDwt;
+#define DWT (& hostDwt )
+#define DWT_CTRL_CYCCNTENA_Msk 1ul
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+extern CoreDebug_Type hostCoreDebug;
+#define CoreDebug (& hostCoreDebug )
+#define CoreDebug_DEMCR_TRCENA_Msk (1ul<<24)
+typedef struct { __IO uint16_t CTL; __IO uint16_t CCTL[7]; __IO uint16_t R; __IO uint16_t CCR[7]; __IO uint16_t EX0; uint16_t r[6]; __I uint16_t IV; } Timer_A_Type;
+extern Timer_A_Type hostTimerA [4];
+#define TIMER_A0 (& hostTimerA [0])
+#define TIMER_A1 (& hostTimerA [1])
+#define TIMER_A2 (& hostTimerA [2])
+#define TIMER_A3 (& hostTimerA [3])
+#define TIMER_A_CTL_SSEL__SMCLK (0x0200)
+#define TIMER_A_CTL_SSEL__ACLK (0x0100)
+#define TIMER_A_CTL_MC__STOP (0x0000)
+#define TIMER_A_CTL_MC__UP (0x0010)
+#define TIMER_A_CTL_MC__CONTINUOUS (0x0020)
+#define TIMER_A_CTL_CLR (0x0004)
+#define TIMER_A_CTL_IE (0x0002)
+#define TIMER_A_CTL_IFG (0x0001)
+#define TIMER_A_CTL_ID_MASK (0x00C0)
+#define TIMER_A_CTL_ID__1 (0x0000)
+#define TIMER_A_CTL_ID__2 (0x0040)
+#define TIMER_A_CTL_ID__4 (0x0080)
+#define TIMER_A_CTL_ID__8 (0x00C0)
+#define TIMER_A_CTL_ID_OFS 6
+#define TIMER_A_CTL_MC_MASK (0x0030)
+#define TIMER_A_EX0_IDEX_MASK 7
+#define TIMER_A_EX0_IDEX__1 0
+#define TIMER_A_CCTLN_OUTMOD_7 (0x00E0)
+#define TIMER_A_CCTLN_OUTMOD_0 (0x0000)
+#define TIMER_A_CCTLN_CCIE (0x0010)
+#define TIMER_A_CCTLN_CCIFG (0x0001)
+#define TIMER_A_CCTLN_COV (0x0002)
+#define TIMER_A_CCTLN_CAP (0x0100)
+#define TIMER_A_CCTLN_SCS (0x0800)
+#define TIMER_A_CCTLN_CM__BOTH (0xC000)
+#define TIMER_A_CCTLN_CCIS__CCIA (0x0000)
+#define TIMER_A_CCTLN_CCI (0x0008)
+#define TIMER_A_CCTLN_OUT (0x0004)
+#define __NVIC_PRIO_BITS 3
+static inline uint32_t __get_PRIMASK(void){return 0;}
+static inline void __set_PRIMASK(uint32_t x){(void)x;}
+static inline uint32_t __get_BASEPRI(void){return 0;}
+static inline void __set_BASEPRI(uint32_t x){(void)x;}
+static inline void __set_BASEPRI_MAX(uint32_t x){(void)x;}
+static inline void __disable_irq(void){}
+static inline void __enable_irq(void){}
+static inline void __WFI(void){}
+static inline void __DSB(void){}
+static inline void __ISB(void){}
+static inline void __DMB(void){}
+static inline uint32_t __LDREXW(volatile uint32_t *a){return *a;}
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *a){*a=v;return 0;}
+static inline void __CLREX(void){}
+typedef struct { __IO uint32_t SCR; } SCB_Type;
+extern SCB_Type hostScb;
+#define SCB (& hostScb )
+#define SCB_SCR_SLEEPDEEP_Msk (1ul<<2)
+#define SCB_SCR_SLEEPONEXIT_Msk (1ul<<1)
+typedef struct { __IO uint32_t CTL0, CTL1, IE, IFG, CLRIFG; } PCM_Type;
+extern PCM_Type hostPcm;
+#define PCM (& hostPcm )
+#define PCM_CTL0_KEY_VAL (0x695A0000)
+#define PCM_CTL0_AMR_MASK (0x0000000F)
+#define PCM_CTL0_AMR_0 (0x0)
+#define PCM_CTL0_AMR_1 (0x1)
+#define PCM_CTL0_AMR_4 (0x4)
+#define PCM_CTL0_AMR_5 (0x5)
+#define PCM_CTL0_CPM_MASK (0x00003F00)
+#define PCM_CTL0_CPM_OFS 8
+#define PCM_CTL1_PMR_BUSY (0x00000100)
+typedef struct { __IO uint32_t POWER_STAT; uint32_t r[3]; __IO uint32_t BANK0_RDCTL, BANK1_RDCTL; } FLCTL_Type;
+extern FLCTL_Type hostFlctl;
+#define FLCTL (& hostFlctl )
+#define FLCTL_BANK0_RDCTL_WAIT_MASK (0x0000F000)
+#define FLCTL_BANK0_RDCTL_WAIT_0 (0x00000000)
+#define FLCTL_BANK0_RDCTL_WAIT_1 (0x00001000)
+#define FLCTL_BANK0_RDCTL_BUFD (0x00000020)
+#define FLCTL_BANK0_RDCTL_BUFI (0x00000010)
+#define FLCTL_BANK1_RDCTL_WAIT_MASK (0x0000F000)
+#define FLCTL_BANK1_RDCTL_WAIT_0 (0x00000000)
+#define FLCTL_BANK1_RDCTL_WAIT_1 (0x00001000)
+#define FLCTL_BANK1_RDCTL_BUFD (0x00000020)
+#define FLCTL_BANK1_RDCTL_BUFI (0x00000010)
+typedef struct { __IO uint32_t KEY, CTL0, CTL1, CTL2, CTL3; } CS_Type;
+extern CS_Type hostCs;
+#define CS (& hostCs )
+#define CS_KEY_VAL (0x0000695A)
+#define CS_CTL0_DCORSEL_MASK (0x00070000)
+#define CS_CTL0_DCORSEL_0 (0x00000000)
+#define CS_CTL0_DCORSEL_1 (0x00010000)
+#define CS_CTL0_DCORSEL_2 (0x00020000)
+#define CS_CTL0_DCORSEL_3 (0x00030000)
+#define CS_CTL0_DCORSEL_4 (0x00040000)
+#define CS_CTL0_DCORSEL_5 (0x00050000)
+#define CS_CTL0_DCOTUNE_MASK (0x000003FF)
+#define CS_CTL1_SELM_MASK (0x00000007)
+#define CS_CTL1_SELM__DCOCLK (0x00000003)
+#define CS_CTL1_DIVM_MASK (0x00070000)
+#define CS_CTL1_DIVS_MASK (0x70000000)
+#define CS_CTL1_DIVS__1 (0x00000000)
+#define CS_CTL1_DIVS__2 (0x10000000)
+#define CS_CTL1_SELS_MASK (0x00000070)
+#define CS_CTL1_SELS__DCOCLK (0x00000030)
+typedef struct { __IO uint16_t CTL0, CTL13, OCAL, TCMP, PS0CTL, PS1CTL, PS, IV, TIM0, TIM1, DATE, YEAR; } RTC_C_Type;
+extern RTC_C_Type hostRtc;
+#define RTC_C (& hostRtc )
+#define RTC_C_KEY ((uint16_t)0xA500)
+#define RTC_C_CTL0_KEY_MASK ((uint16_t)0xFF00)
+#define RTC_C_CTL13_HOLD ((uint16_t)0x0040)
+#define RTC_C_PS1CTL_RT1IP_OFS (2)
+#define RTC_C_PS1CTL_RT1IP_MASK ((uint16_t)0x001C)
+#define RTC_C_PS1CTL_RT1PSIE ((uint16_t)0x0002)
+#define RTC_C_PS1CTL_RT1PSIFG ((uint16_t)0x0001)
+#define CS_CTL1_SELB (0x00001000)
+extern uint32_t SystemCoreClock;
+#endif // HOST_MSP_H
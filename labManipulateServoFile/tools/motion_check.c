@@ -0,0 +1,178 @@
+/**
+* @file motion_check.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Host check of the motion planner ( motion.c )
+*
+* Every move of a matrix of limits ( trapezoid and S-curves, in degrees and
+* at the servo.c scale of 0.01 degree , the servo.c defaults among them ) and
+* of distances ( 0, 1 unit, short moves that never reach vmax, long ones,
+* both directions, the servo range ) is stepped frame by frame on the Q16
+* output position, and checked:
+* - no overshoot: the output never passes the target nor moves backwards
+* - the velocity change per frame never exceeds amax ( per frame units of
+* motionSetLimits (), Q16 ), and the velocity never exceeds vmax, give or
+* take the one Q16 step the S-curve average may carry to the next frame
+* - the move ends exactly on the target, done set and the completion
+* function called once, at most CHECK_SLACK frames later than the ideal
+* trapezoid plus the S-curve ramp
+* Retargets in the middle of a move, which may have to turn back, are checked
+* for the velocity and acceleration limits from the frame before the
+* retarget on, and for their exact end.
+* Exit status 0 when every check passes.
+*
+* Build and run from labManipulateServoFile :
+* gcc -std=gnu11 -Wall -I. tools/motion_check.c motion.c
+* -o tools/motion_check.out
+* tools/motion_check.out
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <stdio.h>
+#include <stdlib.h>
+#include "motion.h"
+
+/* SECTION 2: Private macros */
+#define CHECK_ONE (1L << MOTION_SHIFT ) /**< One unit, Q16 */
+#define CHECK_MAX_FRAMES 1000000 /**< A move that takes longer never ends */
+#define CHECK_ROUND 1 /**< Rounding of the S-curve average on the velocity , Q16 */
+#define CHECK_SLACK 3 /**< Frames of the last approach, above the ideal profile */
+#define CHECK_LIMITS 1 /**< _checkMove (): check vmax and amax */
+#define CHECK_PATH 2 /**< _checkMove (): check no overshoot , no going back and the frames */
+#define CHECK_SERVO 100 /**< servo.c units per degree ( SERVO_POS_SCALE ) */
+
+/* SECTION 3: Private types */
+
+/**
+* @brief Limits of motionSetLimits ()
+*/
+
+typedef struct {
+    uint32_t vmax, amax, jmax;
+} check_limits_t ;
+
+/* SECTION 5: Private variables */
+
+static const check_limits_t _checkLimits [] = {
+    { 90, 360, 0 }, // servo.c defaults
+    { 360, 1440, 7200 }, // bench.c
+    { 180, 720, 720 }, // ramp longer than MOTION_SMOOTH_MAX frames
+    { 1000, 200, 0 }, // never reaches vmax on the servo range
+    { 1, 1, 0 }, // below one unit per frame
+    { 500, 20000, 100000 },
+    { 45, 90, 450 },
+    // servo.c scale, servoSetMotionLimits () multiplies by CHECK_SERVO
+    { 90 * CHECK_SERVO, 360 * CHECK_SERVO, 0 }, // servo.c defaults
+    { 360 * CHECK_SERVO, 1440 * CHECK_SERVO, 7200 * CHECK_SERVO }, // bench.c
+    { 180 * CHECK_SERVO, 720 * CHECK_SERVO, 720 * CHECK_SERVO },
+    { 60 * CHECK_SERVO, 600 * CHECK_SERVO, 3000 * CHECK_SERVO },
+};
+
+static const int32_t _checkMoves [] = { 0, 1, -1, 2, 7, -13, 45, 90, -180, 180, 1000, -4000,
+    90 * CHECK_SERVO, -90 * CHECK_SERVO, 180 * CHECK_SERVO, 1234 };
+
+static uint32_t _checkErrors ;
+static uint32_t _checkDoneCalls ;
+
+/* SECTION 7: Private functions */
+
+static void _checkFail ( const check_limits_t *l, int32_t from, int32_t to, uint32_t frame, const char *what, long got ) {
+    if ( _checkErrors < 20 ){
+        printf ("limits %lu/%lu/%lu move %ld -> %ld frame %lu: %s %ld\n", ( unsigned long ) l->vmax, ( unsigned long ) l->amax,
+            ( unsigned long ) l->jmax, ( long ) from, ( long ) to, ( unsigned long ) frame, what, got );
+    }
+    _checkErrors++;
+}
+
+static void _checkDone ( motion_t *m, void *ctx ) {
+    ( void ) m;
+    ( void ) ctx;
+    _checkDoneCalls++;
+}
+
+/**
+* @brief Step a move to its end
+* @param [in] vel Output velocity of the last frame ( Q16 ), 0 from rest
+* @param [in] strict CHECK_LIMITS and CHECK_PATH , what to check besides the end
+*/
+
+static void _checkMove ( motion_t *m, const check_limits_t *l, int32_t to, int32_t vel, int strict ) {
+    int32_t from = motionGetPosition ( m ), dir = ( to < from ) ? -1 : 1;
+    int32_t prev = m->pos, v, ret;
+    uint32_t frame, bound;
+
+    // Fastest trapezoid is at most d / vmax + vmax / amax, then the ramp
+    bound = ( uint32_t )(( int64_t ) abs ( to - from ) * CHECK_ONE / m->vmax + m->vmax / m->amax + m->hlen + CHECK_SLACK );
+    _checkDoneCalls = 0;
+    motionMoveTo ( m, to );
+    for ( frame = 1; frame <= CHECK_MAX_FRAMES && ! motionIsDone ( m ); frame++ ){
+        ret = motionStep ( m );
+        if ( ret != motionGetPosition ( m )){
+            _checkFail ( l, from, to, frame, "returned", ret );
+        }
+        v = m->pos - prev;
+        prev = m->pos;
+        if ( strict & CHECK_PATH ){
+            if (( int64_t )( m->pos - to * CHECK_ONE ) * dir > 0){
+                _checkFail ( l, from, to, frame, "overshoot ( Q16 )", ( long )( m->pos - to * CHECK_ONE ));
+            }
+            if ( v * dir < 0){
+                _checkFail ( l, from, to, frame, "backwards ( Q16 )", v );
+            }
+        }
+        if ( strict & CHECK_LIMITS ){
+            if ( abs ( v ) > m->vmax + CHECK_ROUND ){
+                _checkFail ( l, from, to, frame, "velocity above vmax ( Q16 )", v - m->vmax * dir );
+            }
+            if ( abs ( v - vel ) > m->amax ){
+                _checkFail ( l, from, to, frame, "acceleration above amax ( Q16 )", v - vel );
+            }
+        }
+        vel = v;
+    }
+    if ( ! motionIsDone ( m )){
+        _checkFail ( l, from, to, frame, "not done after frames", frame );
+    } else if (( strict & CHECK_PATH ) && ( frame - 1 > bound )){
+        _checkFail ( l, from, to, frame, "frames above", bound );
+    } else if (( m->pos != to * CHECK_ONE ) || ( motionGetPosition ( m ) != to )){
+        _checkFail ( l, from, to, frame, "ends at ( Q16 )", m->pos );
+    }
+    if ( _checkDoneCalls != ( from != to || frame > 1)){
+        _checkFail ( l, from, to, frame, "completion calls", _checkDoneCalls );
+    }
+}
+
+int main ( void ) {
+    motion_t m;
+    uint32_t i, j, k, n, moves = 0;
+    int32_t prev;
+    const check_limits_t *l;
+
+    for ( i = 0; i < sizeof ( _checkLimits ) / sizeof ( _checkLimits [0] ); i++ ){
+        l = & _checkLimits [i];
+        for ( j = 0; j < sizeof ( _checkMoves ) / sizeof ( _checkMoves [0] ); j++ ){
+            // From rest
+            motionInit (&m, 0);
+            motionOnDone (&m, _checkDone, NULL );
+            motionSetLimits (&m, l->vmax, l->amax, l->jmax );
+            _checkMove (&m, l, _checkMoves [j], 0, CHECK_LIMITS | CHECK_PATH );
+            // Then back, and a retarget after k frames of a move
+            _checkMove (&m, l, 0, 0, CHECK_LIMITS | CHECK_PATH );
+            for ( k = 1; k < 40; k += 7 ){
+                motionMoveTo (&m, _checkMoves [j] );
+                prev = m.pos;
+                for ( n = 0; ( n < k ) && ! motionIsDone (&m ); n++ ){
+                    prev = m.pos;
+                    motionStep (&m );
+                }
+                _checkMove (&m, l, -_checkMoves [j] / 2 + 3, m.pos - prev, CHECK_LIMITS );
+                moves++;
+            }
+            moves += 2;
+        }
+    }
+    printf ("%lu moves, %lu errors\n", ( unsigned long ) moves, ( unsigned long ) _checkErrors );
+    return _checkErrors ? 1 : 0;
+}
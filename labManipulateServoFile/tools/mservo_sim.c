@@ -0,0 +1,212 @@
+/**
+* @file mservo_sim.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Host simulator of the multi-servo edge schedule ( mservo.c )
+*
+* mservo.c is compiled into this program with Timer_A1 replaced by a model
+* in which every register access costs one timer count, the CPU time of the
+* ISR. Frames are played count by count: TA1_0 at the roll over, TA1_N at
+* every CCR1 match, and the P4 pins are sampled at every timer access.
+* Every frame, random positions ( and now and then a new calibration ) are
+* set right before TA1_0, where mservoFrameCallback () runs ( its weak empty
+* version is linked here ), and checked:
+* - the schedule of the next frame gives every channel exactly the pulse of
+* servoConvCounts () for that position, to the count, rising at its stagger
+* - every edge reaches the pin no earlier than its schedule time and at most
+* SIM_LATENCY counts after it ( ISR entry, nearby edges handled in a row )
+* - every channel has one rising and one falling edge per frame
+* Exit status 0 when every check passes.
+*
+* Build and run from labManipulateServoFile :
+* gcc -std=gnu11 -Wall -Itools/host -I. tools/mservo_sim.c servo.c motion.c
+* traj.c critical.c prio.c tools/host/host.c -o tools/mservo_sim.out
+* tools/mservo_sim.out [ frames ]
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <stdio.h>
+#include <stdlib.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+static Timer_A_Type * _simTimer ( void );
+#undef TIMER_A1
+#define TIMER_A1 _simTimer ()
+#include "../mservo.c"
+#include "prio.h"
+
+/* SECTION 2: Private macros */
+#define SIM_LATENCY 4 /**< Latest an edge may reach its pin ( counts ) */
+#define SIM_MAX_EDGES ( 2 * MSERVO_MAX_CHANNELS + 4) /**< Pin changes kept per frame */
+#define SIM_PIN_MASK ( BIT0 | BIT1 | BIT2 | BIT3 ) /**< P4 pins of the channels */
+
+/* SECTION 3: Private types */
+/**
+* @brief One pin change seen by the model
+*/
+
+typedef struct {
+    uint32_t time ; /**< Counter value */
+    uint8_t ch ; /**< Channel */
+    uint8_t level ; /**< New pin level */
+} sim_edge_t ;
+
+/* SECTION 5: Private variables */
+
+static uint32_t _simNow ; /**< Counter value of the model */
+static uint8_t _simOut ; /**< P4 pins at the last access */
+static sim_edge_t _simEdge [ SIM_MAX_EDGES ]; /**< Pin changes of the frame */
+static uint8_t _simNumEdges ;
+static uint32_t _simWant [ MSERVO_MAX_CHANNELS ]; /**< Pulse expected next frame ( counts ) */
+static uint32_t _simPend [ MSERVO_MAX_CHANNELS ]; /**< Pulse of the positions set this frame */
+static uint32_t _simFrame ;
+static uint32_t _simErrors ;
+static uint32_t _simMaxLate ;
+
+/* SECTION 7: Private functions */
+
+static Timer_A_Type * _simTimer ( void ) {
+    uint8_t out = P4 -> OUT & SIM_PIN_MASK, diff = out ^ _simOut, ch;
+    for ( ch = 0; diff && ( ch < MSERVO_NUM ); ch++ ){
+        if (( diff & mservoPinRef [ch].mask ) && ( _simNumEdges < SIM_MAX_EDGES )){
+            _simEdge [ _simNumEdges ].time = _simNow;
+            _simEdge [ _simNumEdges ].ch = ch;
+            _simEdge [ _simNumEdges ].level = ( out & mservoPinRef [ch].mask ) ? 1 : 0;
+            _simNumEdges++;
+        }
+    }
+    _simOut = out;
+    // The access itself takes one count
+    _simNow++;
+    hostTimerA [1].R = ( uint16_t ) _simNow;
+    return & hostTimerA [1];
+}
+
+/**
+* @brief Report a failed check
+*/
+
+static void _simFail ( const char *what, uint8_t ch, long got, long want ) {
+    if ( _simErrors < 20 ){
+        printf ("frame %lu ch %u: %s %ld, expected %ld\n", ( unsigned long ) _simFrame, ch, what, got, want );
+    }
+    _simErrors++;
+}
+
+/**
+* @brief Set positions as a frame callback would
+*/
+
+static void _simSetPositions ( void ) {
+    servo_cal_t cal = SERVO_CAL_DEFAULT ;
+    uint8_t ch;
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        if ( rand () % 3 == 0 ){
+            // Also whole 0.5 ms steps, so that falling and rising edges meet
+            mservoSetAbsPositionCd ( ch, ( rand () & 1) ? ( uint32_t )( rand () % ( SERVO_POS_MAX + 1))
+                : ( uint32_t )( rand () % 3) * ( SERVO_POS_MAX / 2));
+        }
+        if ( rand () % 50 == 0 ){
+            cal.min_us = 500 + rand () % 600;
+            cal.max_us = 1900 + rand () % 600;
+            cal.trim = ( int16_t )( rand () % 201 - 100);
+            cal.reversed = rand () & 1;
+            mservoSetCalibration ( ch, & cal );
+        }
+        _simPend [ch] = servoConvCounts (& _mservoConv [ch], _mservoPos [ch] );
+    }
+}
+
+/**
+* @brief Check the pin changes of one frame against its schedule
+*/
+
+static void _simCheckFrame ( const mservo_sched_t *s ) {
+    uint32_t rise [ MSERVO_MAX_CHANNELS ] = {0}, fall [ MSERVO_MAX_CHANNELS ] = {0};
+    uint8_t n_rise [ MSERVO_MAX_CHANNELS ] = {0}, n_fall [ MSERVO_MAX_CHANNELS ] = {0};
+    uint8_t i, ch;
+    int32_t late;
+
+    // Schedule: one pulse per channel, at its stagger, of the expected width
+    for ( i = 0; i < s->num; i++ ){
+        ch = s->edge [i].ch;
+        if ( s->edge [i].level ){
+            rise [ch] = s->edge [i].time;
+        } else {
+            fall [ch] = s->edge [i].time;
+        }
+    }
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        if ( rise [ch] != ( uint32_t )( _mservoGuard + ch * _mservoStagger )){
+            _simFail ("rise at", ch, rise [ch], _mservoGuard + ch * _mservoStagger );
+        }
+        if (( _simFrame > 1) && ( fall [ch] - rise [ch] != _simWant [ch] )){
+            _simFail ("scheduled width", ch, ( long )( fall [ch] - rise [ch] ), _simWant [ch] );
+        }
+    }
+    // Pins : every edge on time, once per frame
+    for ( i = 0; i < _simNumEdges; i++ ){
+        ch = _simEdge [i].ch;
+        late = ( int32_t )( _simEdge [i].time - ( _simEdge [i].level ? rise [ch] : fall [ch] ));
+        if (( late < 0) || ( late > SIM_LATENCY )){
+            _simFail ( _simEdge [i].level ? "rising edge late by" : "falling edge late by", ch, late, 0);
+        }
+        if (( late > 0) && (( uint32_t ) late > _simMaxLate )){
+            _simMaxLate = late;
+        }
+        if ( _simEdge [i].level ){
+            n_rise [ch]++;
+        } else {
+            n_fall [ch]++;
+        }
+    }
+    for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+        if (( n_rise [ch] != 1) || ( n_fall [ch] != 1)){
+            _simFail ("edges", ch, n_rise [ch] + n_fall [ch], 2);
+        }
+    }
+}
+
+int main ( int argc, char **argv ) {
+    uint32_t frames = ( argc > 1) ? ( uint32_t ) atol ( argv [1] ) : 2000;
+    uint32_t t, last;
+    uint8_t ch, active;
+
+    srand (1);
+    prioInit ();
+    mservoInit ();
+    for ( _simFrame = 0; _simFrame < frames; _simFrame++ ){
+        // Roll over: the frame ISR, preempted by no edge ( the first one is
+        // MSERVO_GUARD_US away ), its time not counted
+        _simNow = 0;
+        hostTimerA [1].R = 0;
+        active = _mservoActive;
+        for ( ch = 0; ch < MSERVO_NUM; ch++ ){
+            _simWant [ch] = _simPend [ch];
+        }
+        _simSetPositions ();
+        TA1_0_IRQHandler ();
+        _simNumEdges = 0;
+        // Edges of the frame, up to the one that programs the next frame
+        last = 0;
+        while ( hostTimerA [1].CCTL [1] & TIMER_A_CCTLN_CCIE ){
+            t = hostTimerA [1].CCR [1];
+            if (( t < last ) || ( t > _mservoClock.period - 1)){
+                break;
+            }
+            _simNow = t;
+            TA1_N_IRQHandler ();
+            _simTimer (); // Sample the last write
+            last = t + 1;
+        }
+        _simCheckFrame (& _mservoSched [ active ]);
+        if ( _mservoActive == active && _mservoPending ){
+            _simFail ("schedule not handed over", 0, 0, 1);
+        }
+    }
+    printf ("%lu frames, %lu errors, latest edge %lu counts after its time\n", ( unsigned long ) frames,
+        ( unsigned long ) _simErrors, ( unsigned long ) _simMaxLate );
+    return _simErrors ? 1 : 0;
+}
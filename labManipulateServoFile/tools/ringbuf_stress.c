@@ -0,0 +1,163 @@
+/**
+* @file ringbuf_stress.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Linux thread stress test of ringbuf.h
+*
+* ringbuf.h is built in its host mode ( RINGBUF_HOST, C11 atomics ), the
+* threads stand for the ISRs:
+* - ringbuf_t: one producer thread and the main thread as consumer, through
+* a 64 slot ring, STRESS_ITEMS items that must come out in order
+* - ringbuf_mp_t: STRESS_PRODUCERS threads through a 16 slot ring, so the
+* ring is full most of the time and claims collide: every producer's items
+* must come out complete and in its own order
+* - ringbufInit () refuses a length that is not a power of two
+* Threads yield when the ring is full or empty, so a single CPU host also
+* makes progress. Exit status 0 when every check passes.
+*
+* Build and run from labManipulateServoFile :
+* gcc -O2 -std=gnu11 -Wall -pthread -I. tools/ringbuf_stress.c
+* -o tools/ringbuf_stress.out
+* tools/ringbuf_stress.out
+* With -fsanitize=thread added ( and -O1 ), ThreadSanitizer also checks that
+* every slot access is ordered by the index or sequence number
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include "ringbuf.h"
+
+/* SECTION 2: Private macros */
+#define STRESS_ITEMS 200000 /**< Items per producer */
+#define STRESS_PRODUCERS 4 /**< Producer threads of the ringbuf_mp_t */
+#define STRESS_SP_SLOTS 64
+#define STRESS_MP_SLOTS 16
+
+/* SECTION 5: Private variables */
+
+static ringbuf_t _stressSp ;
+static uint64_t _stressSpData [ STRESS_SP_SLOTS ];
+static ringbuf_mp_t _stressMp ;
+static ringbuf_idx_t _stressMpSeq [ STRESS_MP_SLOTS ];
+static uint64_t _stressMpData [ STRESS_MP_SLOTS ];
+
+/* SECTION 7: Private functions */
+
+static void * _stressSpProducer ( void *arg ) {
+    uint64_t i;
+    int32_t k;
+    ( void ) arg;
+
+    for ( i = 0; i < STRESS_ITEMS; ){
+        k = ringbufPutIndex (& _stressSp );
+        if ( k < 0){
+            sched_yield ();
+            continue;
+        }
+        _stressSpData [k] = i * 7 + 1;
+        ringbufPutDone (& _stressSp );
+        i++;
+    }
+    return NULL;
+}
+
+static void * _stressMpProducer ( void *arg ) {
+    uint64_t id = ( uintptr_t ) arg, i;
+    uint32_t ticket;
+    int32_t k;
+
+    for ( i = 0; i < STRESS_ITEMS; ){
+        k = ringbufMpPutIndex (& _stressMp, & ticket );
+        if ( k < 0){
+            sched_yield ();
+            continue;
+        }
+        _stressMpData [k] = ( id << 32) | i;
+        ringbufMpPutDone (& _stressMp, ticket );
+        i++;
+    }
+    return NULL;
+}
+
+/**
+* @brief One producer, main thread as consumer
+*/
+
+static int _stressSpsc ( void ) {
+    pthread_t th;
+    uint64_t i;
+    int32_t k;
+
+    ringbufInit (& _stressSp, STRESS_SP_SLOTS );
+    pthread_create (& th, NULL, _stressSpProducer, NULL );
+    for ( i = 0; i < STRESS_ITEMS; ){
+        k = ringbufGetIndex (& _stressSp );
+        if ( k < 0){
+            sched_yield ();
+            continue;
+        }
+        if ( _stressSpData [k] != i * 7 + 1){
+            printf ("ringbuf_t: item %lu reads %lu\n", ( unsigned long ) i, ( unsigned long ) _stressSpData [k] );
+            return 1;
+        }
+        ringbufGetDone (& _stressSp );
+        i++;
+    }
+    pthread_join ( th, NULL );
+    return ringbufCount (& _stressSp ) != 0;
+}
+
+/**
+* @brief Several producers, main thread as consumer
+*/
+
+static int _stressMpsc ( void ) {
+    pthread_t th [ STRESS_PRODUCERS ];
+    uint64_t next [ STRESS_PRODUCERS ] = {0}, n, v;
+    uintptr_t p;
+    uint32_t id;
+    int32_t k;
+
+    ringbufMpInit (& _stressMp, _stressMpSeq, STRESS_MP_SLOTS );
+    for ( p = 0; p < STRESS_PRODUCERS; p++ ){
+        pthread_create (& th [p], NULL, _stressMpProducer, ( void *) p );
+    }
+    for ( n = 0; n < ( uint64_t ) STRESS_ITEMS * STRESS_PRODUCERS; ){
+        k = ringbufMpGetIndex (& _stressMp );
+        if ( k < 0){
+            sched_yield ();
+            continue;
+        }
+        v = _stressMpData [k];
+        id = ( uint32_t )( v >> 32);
+        if (( id >= STRESS_PRODUCERS ) || (( v & 0xFFFFFFFF ) != next [id] )){
+            printf ("ringbuf_mp_t: producer %u item %lu\n", id, ( unsigned long )( v & 0xFFFFFFFF ));
+            return 1;
+        }
+        next [id]++;
+        ringbufMpGetDone (& _stressMp );
+        n++;
+    }
+    for ( p = 0; p < STRESS_PRODUCERS; p++ ){
+        pthread_join ( th [p], NULL );
+    }
+    return ringbufMpGetIndex (& _stressMp ) != -1;
+}
+
+int main ( void ) {
+    ringbuf_t bad;
+    int errors = 0;
+
+    if ( ringbufInit (& bad, 12) != -1){
+        printf ("ringbufInit: length 12 accepted\n");
+        errors++;
+    }
+    errors += _stressSpsc ();
+    errors += _stressMpsc ();
+    printf ("%d errors\n", errors );
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+/**
+* @file smeas_trace.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Host trace mode of the pulse measurement ( smeas.c )
+*
+* Feeds smeasEdge () with the edges of a servo signal and prints the
+* histograms, as smeasGetStats () gives them on the board:
+* - smeas_trace [ width_us ] < trace.txt
+* one edge per line, "<capture count> <level>", counts of the SMCLK
+* (3 MHz ) capture clock, 16 bits, as TA2CCR1 and CCI give them
+* - smeas_trace -g [ pulses [ jitter ]]
+* generates the trace from servo.c itself at 90 degrees : the frame ISR is
+* run once per period and the pulse is read back from TA0CCR2, then every
+* edge is moved by a random jitter of up to +- jitter counts
+*
+* Build and run from labManipulateServoFile :
+* gcc -std=gnu11 -Wall -Itools/host -I. tools/smeas_trace.c smeas.c servo.c
+* motion.c traj.c critical.c tools/host/host.c -o tools/smeas_trace.out
+* tools/smeas_trace.out -g 500 3
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include "smeas.h"
+#include "servo.h"
+
+/* SECTION 2: Private macros */
+#define TRACE_WIDTH_US 1500 /**< Pulse of the 90 degrees position */
+
+/* SECTION 6: Private functions :: declarations */
+
+void TA0_0_IRQHandler ( void );
+
+/**
+* @brief Edges of the servo signal from servo.c, with jitter
+*/
+
+static void _traceGenerate ( uint32_t pulses, int32_t jitter );
+
+/**
+* @brief Edges from stdin
+* @return Edges read
+*/
+
+static uint32_t _traceRead ( void );
+
+/**
+* @brief Print a histogram and its extremes
+*/
+
+static void _tracePrint ( const char *name, const uint32_t *hist, int32_t min, int32_t max, uint32_t bin_ns );
+
+/* SECTION 7: Private functions :: definitions */
+
+static void _traceGenerate ( uint32_t pulses, int32_t jitter ) {
+    uint32_t t = 0, i;
+    int32_t j0, j1;
+    servoInit ();
+    for ( i = 0; i < pulses; i++ ){
+        TA0_0_IRQHandler ();
+        j0 = jitter ? ( rand () % (2 * jitter + 1)) - jitter : 0;
+        j1 = jitter ? ( rand () % (2 * jitter + 1)) - jitter : 0;
+        smeasEdge (( uint16_t )( t + j0 ), 1);
+        smeasEdge (( uint16_t )( t + TIMER_A0 -> CCR [2] + j1 ), 0);
+        t += TIMER_A0 -> CCR [0] + 1u;
+    }
+}
+
+static uint32_t _traceRead ( void ) {
+    unsigned long t;
+    unsigned level;
+    uint32_t n = 0;
+    while ( scanf ("%lu %u", & t, & level ) == 2 ){
+        smeasEdge (( uint16_t ) t, level ? 1 : 0);
+        n++;
+    }
+    return n;
+}
+
+static void _tracePrint ( const char *name, const uint32_t *hist, int32_t min, int32_t max, uint32_t bin_ns ) {
+    int i;
+    printf ("%s: min %ld ns, max %ld ns\n", name, ( long ) min, ( long ) max );
+    for ( i = 0; i < SMEAS_BINS; i++ ){
+        if ( hist [i] ){
+            printf ("  %+6ld ns %lu\n", ( long )( i - SMEAS_BINS / 2) * ( long ) bin_ns, ( unsigned long ) hist [i] );
+        }
+    }
+}
+
+int main ( int argc, char **argv ) {
+    smeas_stats_t st;
+    uint32_t width_us = TRACE_WIDTH_US;
+
+    smeasInit ();
+    if (( argc > 1) && ( strcmp ( argv [1], "-g" ) == 0)){
+        smeasStart ( TRACE_WIDTH_US );
+        _traceGenerate (( argc > 2) ? ( uint32_t ) atol ( argv [2] ) : 500, ( argc > 3) ? atoi ( argv [3] ) : 0);
+    } else {
+        if ( argc > 1 ){
+            width_us = ( uint32_t ) atol ( argv [1] );
+        }
+        smeasStart ( width_us );
+        _traceRead ();
+    }
+    smeasGetStats (& st );
+    printf ("pulses %lu, lost %lu, resolution %lu ns, bin %lu ns\n", ( unsigned long ) st.pulses,
+        ( unsigned long ) st.lost, ( unsigned long ) st.resolution_ns, ( unsigned long ) st.bin_ns );
+    _tracePrint ("width error", st.width, st.width_min, st.width_max, st.bin_ns );
+    _tracePrint ("period jitter", st.period, st.period_min, st.period_max, st.bin_ns );
+    return 0;
+}
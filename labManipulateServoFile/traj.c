@@ -0,0 +1,228 @@
+/**
+* @file traj.c
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Waypoint trajectory queue played back one step per PWM frame
+*
+* The frame keeps the segment being played out of the ring ( seg ), so the
+* producer can reuse its slot at once. The segment fraction is
+* t_ms * inv_dt in Q24, inv_dt being 2^24 / dt_ms from trajPush ().
+*
+* The cubic is the Hermite form of Catmull - Rom: tangents ( p1 - p_prev ) / 2
+* and ( p2 - p0 ) / 2, p2 being the next queued waypoint, or p1 when there is
+* none yet ( the curve then flattens out at p1 ).
+*
+*/
+
+/* SECTION 1: Included header files to compile this file */
+#include <ti/devices/msp432p4xx/inc/msp.h>
+#include "traj.h"
+#include "ramfunc.h"
+
+/* SECTION 2: Private macros */
+#define TRAJ_QUEUE_MASK ( TRAJ_QUEUE_LEN - 1)
+#define TRAJ_Q24 (1UL << 24) /**< One segment in the Q24 fraction */
+
+/* SECTION 3: Private types */
+
+/* SECTION 4: Public variables :: definitions , no extern
+( must match declarations in header file ) */
+
+/* SECTION 5: Private variables :: definitions , static mandatory
+(no need to declare , definitions include declarations ) */
+
+/* SECTION 6: Private functions :: declarations , static mandatory
+Rule exception ( ISRs ) :: declarations , no static */
+
+/**
+* @brief Take the oldest waypoint ( consumer )
+* @return 1 if *p was set, 0 if the queue is empty
+*/
+
+static int _trajPop ( traj_t *t, traj_point_t *p );
+
+/**
+* @brief Position of the oldest waypoint, or def if the queue is empty
+*/
+
+static int32_t _trajPeek ( const traj_t *t, int32_t def );
+
+/**
+* @brief Position at the current time of the segment
+*/
+
+static int32_t _trajInterpolate ( const traj_t *t );
+
+    /* SECTION 7: Private functions :: definitions , static mandatory
+    Rule exception ( ISRs ) :: definitions , no static
+    Public functions :: definitions , no extern
+    Function definitions ( private & public ) written in any order */
+
+RAMFUNC static int _trajPop ( traj_t *t, traj_point_t *p ) {
+    uint8_t tail = t->tail;
+    if ( tail == t->head ){
+        return 0;
+    }
+    // No slot read before the index read
+    __DMB ();
+    *p = t->queue [ tail & TRAJ_QUEUE_MASK ];
+    // Free the slot only once it has been copied
+    __DMB ();
+    t->tail = tail + 1;
+    return 1;
+}
+
+RAMFUNC static int32_t _trajPeek ( const traj_t *t, int32_t def ) {
+    uint8_t tail = t->tail;
+    if ( tail == t->head ){
+        return def;
+    }
+    __DMB ();
+    return t->queue [ tail & TRAJ_QUEUE_MASK ].pos;
+}
+
+RAMFUNC static int32_t _trajInterpolate ( const traj_t *t ) {
+    uint32_t f24, s, s2, s3;
+    int32_t p0 = t->p0, p1 = t->seg.pos, h01, h10, h11;
+    int64_t acc;
+
+    f24 = t->t_ms * t->seg.inv_dt ;
+    if ( t->mode == TRAJ_LINEAR ){
+        return p0 + ( int32_t )((( int64_t )( p1 - p0 ) * f24 + TRAJ_Q24 / 2) >> 24);
+    }
+    // Hermite basis in Q16 ( h00 = 1 - h01 is folded into p0 )
+    s = f24 >> 8;
+    s2 = ( s * s ) >> 16;
+    s3 = ( s2 * s ) >> 16;
+    h01 = 3 * ( int32_t ) s2 - 2 * ( int32_t ) s3;
+    h10 = ( int32_t ) s3 - 2 * ( int32_t ) s2 + ( int32_t ) s;
+    h11 = ( int32_t ) s3 - ( int32_t ) s2;
+    // Tangents are kept doubled , hence the extra shift
+    acc = ( int64_t ) h01 * 2 * ( p1 - p0 )
+        + ( int64_t ) h10 * ( p1 - t->p_prev )
+        + ( int64_t ) h11 * ( _trajPeek ( t, p1 ) - p0 );
+    return p0 + ( int32_t )(( acc + (1L << 16)) >> 17);
+}
+
+void trajInit ( traj_t *t ) {
+    t->playing = 0;
+    t->ending = 0;
+    t->head = 0;
+    t->tail = 0;
+    t->in_seg = 0;
+    t->starved = 0;
+    t->mode = TRAJ_LINEAR;
+    t->p0 = 0;
+    t->p_prev = 0;
+    t->t_ms = 0;
+    t->stats.points = 0;
+    t->stats.underruns = 0;
+    t->stats.starved_frames = 0;
+    t->stats.min_level = TRAJ_QUEUE_LEN;
+}
+
+int trajPush ( traj_t *t, uint16_t dt_ms, int32_t pos ) {
+    uint8_t head = t->head;
+    traj_point_t *p;
+
+    if (( dt_ms == 0) || (( uint8_t )( head - t->tail ) >= TRAJ_QUEUE_LEN )){
+        return -1;
+    }
+    // The slot is not written before the tail read says it is free
+    __DMB ();
+    p = &t->queue [ head & TRAJ_QUEUE_MASK ];
+    p->pos = pos;
+    p->dt_ms = dt_ms;
+    p->inv_dt = TRAJ_Q24 / dt_ms;
+    // Publish the slot only once it is complete: the barrier keeps the
+    // compiler and the bus from moving the slot stores after the index store
+    __DMB ();
+    t->head = head + 1;
+    return 0;
+}
+
+int trajGetFree ( const traj_t *t ) {
+    return TRAJ_QUEUE_LEN - ( uint8_t )( t->head - t->tail );
+}
+
+void trajStart ( traj_t *t, int32_t pos, traj_mode_t mode ) {
+    t->playing = 0;
+    t->mode = mode;
+    t->p0 = pos;
+    t->p_prev = pos;
+    t->t_ms = 0;
+    t->in_seg = 0;
+    t->starved = 0;
+    t->ending = 0;
+    t->stats.points = 0;
+    t->stats.underruns = 0;
+    t->stats.starved_frames = 0;
+    t->stats.min_level = TRAJ_QUEUE_LEN;
+    // Last : the frame only looks at the rest once this is set
+    t->playing = 1;
+}
+
+void trajEnd ( traj_t *t ) {
+    t->ending = 1;
+}
+
+void trajStop ( traj_t *t ) {
+    // Once playing is clear the frame does not consume, so the foreground
+    // can take the consumer side and empty the ring
+    t->playing = 0;
+    t->tail = t->head;
+    t->in_seg = 0;
+}
+
+RAMFUNC int trajIsPlaying ( const traj_t *t ) {
+    return t->playing;
+}
+
+RAMFUNC int trajStep ( traj_t *t, int32_t *pos ) {
+    uint8_t level;
+
+    if (! t->playing ){
+        return 0;
+    }
+    if ( t->in_seg ){
+        t->t_ms += TRAJ_FRAME_MS;
+    }
+    // Move on to the next segment(s), several if they are shorter than a frame
+    while (! t->in_seg || ( t->t_ms >= t->seg.dt_ms )){
+        if ( t->in_seg ){
+            t->t_ms -= t->seg.dt_ms;
+            t->p_prev = t->p0;
+            t->p0 = t->seg.pos;
+            t->in_seg = 0;
+            t->stats.points++;
+        }
+        level = ( uint8_t )( t->head - t->tail );
+        if ( level < t->stats.min_level ){
+            t->stats.min_level = level;
+        }
+        if (! _trajPop ( t, &t->seg )){
+            // Nothing queued : the end, or an underrun. Hold the last waypoint
+            t->t_ms = 0;
+            if ( t->ending ){
+                t->playing = 0;
+            } else {
+                if (! t->starved ){
+                    t->starved = 1;
+                    t->stats.underruns++;
+                }
+                t->stats.starved_frames++;
+            }
+            *pos = t->p0;
+            return 1;
+        }
+        t->in_seg = 1;
+        t->starved = 0;
+    }
+    *pos = _trajInterpolate ( t );
+    return 1;
+}
+
+void trajGetStats ( const traj_t *t, traj_stats_t *stats ) {
+    *stats = t->stats;
+}
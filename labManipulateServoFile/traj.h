@@ -0,0 +1,149 @@
+/**
+* @file traj.h
+* @author Alexander Ghyoot, Michal Kos
+* @date October 2026
+*
+* @brief Waypoint trajectory queue played back one step per PWM frame
+*
+* Main characteristics of this module :
+* - A trajectory is a stream of ( time, position ) waypoints: dt_ms after
+* the previous waypoint the axis must be at pos
+* - Waypoints wait in a fixed-size ring with one producer ( application ,
+* UART link, script ) and one consumer ( the frame ISR calling trajStep ),
+* lock-free: the producer only writes head, the consumer only writes tail,
+* and a barrier orders the slots against the indexes
+* - Between two waypoints the position is interpolated linearly or with a
+* cubic ( Catmull - Rom ) through the neighbour waypoints. The division by
+* dt_ms happens in trajPush (), the frame only multiplies
+* - Running out of waypoints before trajEnd () is an underrun: the axis
+* holds the last waypoint, and the underrun is counted in the statistics
+* - Unit agnostic, like motion.c: positions are integers in any unit
+*
+*/
+#ifndef TRAJ_H
+#define TRAJ_H
+/* SECTION 1: Included header files to compile this file */
+#include <stdint.h>
+/* SECTION 2: Public macros */
+#define TRAJ_FRAME_MS 20 /**< Time between two calls to trajStep () */
+#define TRAJ_QUEUE_LEN 32 /**< Waypoints in the ring, must be a power of two */
+/* SECTION 3: Public types */
+
+/**
+* @brief Interpolation between waypoints
+*/
+
+typedef enum {
+    TRAJ_LINEAR , /**< Straight line , velocity steps at every waypoint */
+    TRAJ_CUBIC /**< Catmull - Rom cubic , continuous velocity */
+} traj_mode_t ;
+
+/**
+* @brief One waypoint
+*/
+
+typedef struct {
+    int32_t pos ; /**< Position at the end of the segment */
+    uint16_t dt_ms ; /**< Duration of the segment */
+    uint32_t inv_dt ; /**< 2^24 / dt_ms , computed by trajPush () */
+} traj_point_t ;
+
+/**
+* @brief Playback statistics
+*/
+
+typedef struct {
+    uint32_t points ; /**< Waypoints reached */
+    uint32_t underruns ; /**< Times the queue ran dry before trajEnd () */
+    uint32_t starved_frames ; /**< Frames spent holding because of an underrun */
+    uint8_t min_level ; /**< Fewest waypoints queued at a segment change */
+} traj_stats_t ;
+
+/**
+* @brief State of one trajectory. Fields are private to traj.c
+*/
+
+typedef struct {
+    traj_point_t queue [ TRAJ_QUEUE_LEN ];
+    volatile uint8_t head ; /**< Next slot to write, producer only */
+    volatile uint8_t tail ; /**< Next slot to read, consumer only */
+    traj_point_t seg ; /**< End of the segment being played */
+    int32_t p_prev ; /**< Waypoint before the segment start ( cubic ) */
+    int32_t p0 ; /**< Segment start */
+    uint32_t t_ms ; /**< Time into the segment */
+    uint8_t mode ; /**< traj_mode_t */
+    uint8_t in_seg ; /**< Flag (0/1), seg is valid */
+    volatile uint8_t playing ; /**< Flag (0/1), trajStep () runs the queue */
+    volatile uint8_t ending ; /**< Flag (0/1), no waypoints will follow */
+    uint8_t starved ; /**< Flag (0/1), holding because of an underrun */
+    traj_stats_t stats ;
+} traj_t ;
+
+/* SECTION 4: Public variables :: declarations , extern mandatory */
+/* SECTION 5: Public functions :: declarations , extern optional
+Rule exception ( callbacks ) :: declarations , extern recommended */
+
+/**
+* @brief Initialize a stopped trajectory with an empty queue
+*/
+
+void trajInit ( traj_t *t );
+
+/**
+* @brief Append a waypoint ( producer )
+* @param [in] dt_ms Time from the previous waypoint, > 0
+* @param [in] pos Position to reach
+* @return 0 if queued , -1 if the queue is full or dt_ms is 0
+*/
+
+int trajPush ( traj_t *t, uint16_t dt_ms, int32_t pos );
+
+/**
+* @brief Waypoints that can still be pushed
+*/
+
+int trajGetFree ( const traj_t *t );
+
+/**
+* @brief Start playing the queue from a position ( foreground )
+* @param [in] pos Current position of the axis, start of the first segment
+* @param [in] mode Interpolation
+* Waypoints pushed before the call are kept, statistics are cleared
+*/
+
+void trajStart ( traj_t *t, int32_t pos, traj_mode_t mode );
+
+/**
+* @brief Mark the end of the trajectory: playback stops once the queue is
+* empty, without counting an underrun
+*/
+
+void trajEnd ( traj_t *t );
+
+/**
+* @brief Stop at once and drop the queued waypoints ( foreground )
+*/
+
+void trajStop ( traj_t *t );
+
+/**
+* @brief Flag (0/1), the trajectory is playing
+*/
+
+int trajIsPlaying ( const traj_t *t );
+
+/**
+* @brief Advance one frame ( consumer, frame ISR )
+* @param [out] pos Position for this frame
+* @return 1 if *pos was set, 0 if the trajectory is not playing
+*/
+
+int trajStep ( traj_t *t, int32_t *pos );
+
+/**
+* @brief Copy of the playback statistics
+*/
+
+void trajGetStats ( const traj_t *t, traj_stats_t *stats );
+
+#endif // TRAJ_H